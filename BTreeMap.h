@@ -0,0 +1,666 @@
+/** @file */
+#ifndef __BTREEMAP_H
+#define __BTREEMAP_H
+
+#include "ElementNotExist.h"
+#include <cstddef>
+
+/**
+ * BTreeMap is a B+tree implementation of map with the interface of TreeMap.
+ * Nodes hold up to B keys in contiguous arrays, so a lookup touches about
+ * log_B(n) nodes instead of log2(n), and only the leaves hold values. The
+ * leaves are linked in key order, so iterating a range walks arrays rather
+ * than tree pointers. K and V must be default-constructible, and B must be
+ * at least 4.
+ *
+ * Since keys and values are stored apart, the iterator returns an Entry
+ * owned by the iterator, valid until the next call to next().
+ */
+template <class K, class V, int B = 32>
+class BTreeMap
+{
+public:
+    class Entry
+    {
+        K key;
+        V value;
+    public:
+        Entry() {}
+
+        Entry(K k, V v)
+        {
+            key = k;
+            value = v;
+        }
+
+        K getKey() const
+        {
+            return key;
+        }
+
+        V getValue() const
+        {
+            return value;
+        }
+    };
+
+private:
+	struct node {
+		int n;
+		bool isLeaf;
+		K keys[B];
+		node(bool isLeaf) : n(0), isLeaf(isLeaf) {}
+	};
+	struct leaf : node {
+		V vals[B];
+		leaf *pre, *next;
+		leaf() : node(true), pre(NULL), next(NULL) {}
+	};
+	// son[i] holds the keys in [keys[i-1], keys[i])
+	struct inner : node {
+		node *son[B+1];
+		inner() : node(false) {}
+	};
+	// every node but the root is at least half full, so 32 levels are
+	// more than an int-sized map can use
+	const static int MAXH=32;
+
+	node *root;
+	leaf *front, *rear;
+	int Size;
+
+	/**
+	 * Returns the number of keys in a[0..n) less than key. The loop has no
+	 * data-dependent branch and vectorizes for arithmetic keys.
+	 */
+	static int countLess(const K *a, int n, const K &key) {
+		int c=0;
+		for (int i=0; i<n; ++i) c+=(a[i]<key);
+		return c;
+	}
+
+	/**
+	 * Returns the number of keys in a[0..n) not greater than key.
+	 */
+	static int countNotGreater(const K *a, int n, const K &key) {
+		int c=0;
+		for (int i=0; i<n; ++i) c+=!(key<a[i]);
+		return c;
+	}
+
+	static void release(node *x) {
+		if (x->isLeaf) {
+			delete static_cast<leaf *>(x);
+		} else {
+			delete static_cast<inner *>(x);
+		}
+	}
+
+	static void destroy(node *x) {
+		if (!x->isLeaf) {
+			inner *y=static_cast<inner *>(x);
+			for (int i=0; i<=y->n; ++i) destroy(y->son[i]);
+		}
+		release(x);
+	}
+
+	/**
+	 * Copies the subtree x, appending its leaves after last.
+	 */
+	node *copy(const node *x, leaf *&last) {
+		if (x->isLeaf) {
+			leaf *y=new leaf(*static_cast<const leaf *>(x));
+			y->pre=last;
+			y->next=NULL;
+			if (last!=NULL) {
+				last->next=y;
+			} else {
+				front=y;
+			}
+			last=y;
+			return y;
+		}
+		const inner *s=static_cast<const inner *>(x);
+		inner *y=new inner;
+		y->n=s->n;
+		for (int i=0; i<s->n; ++i) y->keys[i]=s->keys[i];
+		for (int i=0; i<=s->n; ++i) y->son[i]=copy(s->son[i],last);
+		return y;
+	}
+
+	void copyFrom(const BTreeMap &x) {
+		root=NULL;
+		front=rear=NULL;
+		Size=x.Size;
+		if (x.root!=NULL) root=copy(x.root,rear);
+	}
+
+	/**
+	 * Descends to the leaf that may hold key. If path is not NULL, records
+	 * the inner nodes passed and the index of the son taken in each.
+	 */
+	leaf *descend(const K &key, inner **path, int *idx, int &h) const {
+		node *cur=root;
+		h=0;
+		while (!cur->isLeaf) {
+			inner *x=static_cast<inner *>(cur);
+			int i=countNotGreater(x->keys,x->n,key);
+			if (path!=NULL) {
+				path[h]=x;
+				idx[h]=i;
+			}
+			++h;
+			cur=x->son[i];
+		}
+		return static_cast<leaf *>(cur);
+	}
+
+	/**
+	 * Returns the leaf holding key and its position in pos, or NULL.
+	 */
+	leaf *find(const K &key, int &pos) const {
+		if (root==NULL) return NULL;
+		int h;
+		leaf *l=descend(key,NULL,NULL,h);
+		pos=countLess(l->keys,l->n,key);
+		if (pos<l->n&&!(key<l->keys[pos])) return l;
+		return NULL;
+	}
+
+	/**
+	 * Sets (l, pos) to the first position whose key is greater than or
+	 * equal to key (strictly greater if strict); l is NULL past the end.
+	 */
+	void seek(const K &key, bool strict, leaf *&l, int &pos) const {
+		l=NULL;
+		pos=0;
+		if (root==NULL) return;
+		int h;
+		l=descend(key,NULL,NULL,h);
+		pos=strict?countNotGreater(l->keys,l->n,key):countLess(l->keys,l->n,key);
+		if (pos==l->n) {
+			l=l->next;
+			pos=0;
+		}
+	}
+
+	/**
+	 * Moves (l, pos) one position back; from past the end it moves to the
+	 * last key, and from the first key to NULL.
+	 */
+	void stepBack(leaf *&l, int &pos) const {
+		if (l==NULL) {
+			l=rear;
+		} else if (pos>0) {
+			--pos;
+			return;
+		} else {
+			l=l->pre;
+		}
+		pos=(l==NULL?0:l->n-1);
+	}
+
+	static K keyAt(leaf *l, int pos) {
+		if (l==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return l->keys[pos];
+	}
+
+	static void insertLeaf(leaf *l, int pos, const K &key, const V &value) {
+		for (int i=l->n; i>pos; --i) {
+			l->keys[i]=l->keys[i-1];
+			l->vals[i]=l->vals[i-1];
+		}
+		l->keys[pos]=key;
+		l->vals[pos]=value;
+		++l->n;
+	}
+
+	static void eraseLeaf(leaf *l, int pos) {
+		for (int i=pos+1; i<l->n; ++i) {
+			l->keys[i-1]=l->keys[i];
+			l->vals[i-1]=l->vals[i];
+		}
+		--l->n;
+	}
+
+	/**
+	 * Inserts separator key and right son right after son[i] of x.
+	 */
+	static void insertInner(inner *x, int i, const K &key, node *right) {
+		for (int j=x->n; j>i; --j) {
+			x->keys[j]=x->keys[j-1];
+			x->son[j+1]=x->son[j];
+		}
+		x->keys[i]=key;
+		x->son[i+1]=right;
+		++x->n;
+	}
+
+	/**
+	 * Removes separator keys[i] and son[i+1] from x.
+	 */
+	static void eraseInner(inner *x, int i) {
+		for (int j=i+1; j<x->n; ++j) {
+			x->keys[j-1]=x->keys[j];
+			x->son[j]=x->son[j+1];
+		}
+		--x->n;
+	}
+
+	void insert(const K &key, const V &value) {
+		if (root==NULL) root=front=rear=new leaf;
+		inner *path[MAXH];
+		int idx[MAXH], h;
+		leaf *l=descend(key,path,idx,h);
+		int pos=countLess(l->keys,l->n,key);
+		if (pos<l->n&&!(key<l->keys[pos])) {
+			l->vals[pos]=value;
+			return;
+		}
+		++Size;
+		if (l->n<B) {
+			insertLeaf(l,pos,key,value);
+			return;
+		}
+		// split the full leaf so that the left half keeps (B+1)/2 entries
+		leaf *r=new leaf;
+		int half=(B+1)/2, from=(pos<half?half-1:half);
+		for (int i=from; i<B; ++i) {
+			r->keys[i-from]=l->keys[i];
+			r->vals[i-from]=l->vals[i];
+		}
+		r->n=B-from;
+		l->n=from;
+		if (pos<half) {
+			insertLeaf(l,pos,key,value);
+		} else {
+			insertLeaf(r,pos-half,key,value);
+		}
+		r->next=l->next;
+		if (l->next!=NULL) {
+			l->next->pre=r;
+		} else {
+			rear=r;
+		}
+		r->pre=l;
+		l->next=r;
+		// push separators up while the parents are full
+		K sep=r->keys[0];
+		node *right=r;
+		while (h>0) {
+			inner *p=path[--h];
+			int i=idx[h];
+			if (p->n<B) {
+				insertInner(p,i,sep,right);
+				return;
+			}
+			K tk[B+1];
+			node *ts[B+2];
+			for (int j=0; j<i; ++j) tk[j]=p->keys[j];
+			for (int j=0; j<=i; ++j) ts[j]=p->son[j];
+			tk[i]=sep;
+			ts[i+1]=right;
+			for (int j=i; j<B; ++j) {
+				tk[j+1]=p->keys[j];
+				ts[j+2]=p->son[j+1];
+			}
+			int m=B/2;
+			inner *q=new inner;
+			for (int j=0; j<m; ++j) p->keys[j]=tk[j];
+			for (int j=0; j<=m; ++j) p->son[j]=ts[j];
+			p->n=m;
+			q->n=B-m;
+			for (int j=0; j<q->n; ++j) q->keys[j]=tk[m+1+j];
+			for (int j=0; j<=q->n; ++j) q->son[j]=ts[m+1+j];
+			sep=tk[m];
+			right=q;
+		}
+		inner *x=new inner;
+		x->n=1;
+		x->keys[0]=sep;
+		x->son[0]=root;
+		x->son[1]=right;
+		root=x;
+	}
+
+	/**
+	 * Refills son[i] of p, which has fallen below B/2 keys, from a sibling.
+	 */
+	void borrowLeft(inner *p, int i) {
+		node *cur=p->son[i], *l=p->son[i-1];
+		if (cur->isLeaf) {
+			leaf *x=static_cast<leaf *>(cur), *y=static_cast<leaf *>(l);
+			insertLeaf(x,0,y->keys[y->n-1],y->vals[y->n-1]);
+			--y->n;
+			p->keys[i-1]=x->keys[0];
+			return;
+		}
+		inner *x=static_cast<inner *>(cur), *y=static_cast<inner *>(l);
+		for (int j=x->n; j>0; --j) x->keys[j]=x->keys[j-1];
+		for (int j=x->n+1; j>0; --j) x->son[j]=x->son[j-1];
+		x->keys[0]=p->keys[i-1];
+		x->son[0]=y->son[y->n];
+		++x->n;
+		p->keys[i-1]=y->keys[y->n-1];
+		--y->n;
+	}
+
+	void borrowRight(inner *p, int i) {
+		node *cur=p->son[i], *r=p->son[i+1];
+		if (cur->isLeaf) {
+			leaf *x=static_cast<leaf *>(cur), *y=static_cast<leaf *>(r);
+			x->keys[x->n]=y->keys[0];
+			x->vals[x->n]=y->vals[0];
+			++x->n;
+			eraseLeaf(y,0);
+			p->keys[i]=y->keys[0];
+			return;
+		}
+		inner *x=static_cast<inner *>(cur), *y=static_cast<inner *>(r);
+		x->keys[x->n]=p->keys[i];
+		x->son[x->n+1]=y->son[0];
+		++x->n;
+		p->keys[i]=y->keys[0];
+		for (int j=1; j<y->n; ++j) y->keys[j-1]=y->keys[j];
+		for (int j=1; j<=y->n; ++j) y->son[j-1]=y->son[j];
+		--y->n;
+	}
+
+	/**
+	 * Merges son[i+1] of p into son[i].
+	 */
+	void mergeSons(inner *p, int i) {
+		node *l=p->son[i], *r=p->son[i+1];
+		if (l->isLeaf) {
+			leaf *x=static_cast<leaf *>(l), *y=static_cast<leaf *>(r);
+			for (int j=0; j<y->n; ++j) {
+				x->keys[x->n+j]=y->keys[j];
+				x->vals[x->n+j]=y->vals[j];
+			}
+			x->n+=y->n;
+			x->next=y->next;
+			if (y->next!=NULL) {
+				y->next->pre=x;
+			} else {
+				rear=x;
+			}
+		} else {
+			inner *x=static_cast<inner *>(l), *y=static_cast<inner *>(r);
+			x->keys[x->n]=p->keys[i];
+			for (int j=0; j<y->n; ++j) x->keys[x->n+1+j]=y->keys[j];
+			for (int j=0; j<=y->n; ++j) x->son[x->n+1+j]=y->son[j];
+			x->n+=y->n+1;
+		}
+		release(r);
+		eraseInner(p,i);
+	}
+
+	void del(const K &key) {
+		inner *path[MAXH];
+		int idx[MAXH], h;
+		if (root==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		leaf *l=descend(key,path,idx,h);
+		int pos=countLess(l->keys,l->n,key);
+		if (pos==l->n||key<l->keys[pos]) throw ElementNotExist("\nElement Not Exist\n");
+		eraseLeaf(l,pos);
+		--Size;
+		node *cur=l;
+		while (h>0) {
+			if (cur->n>=B/2) return;
+			inner *p=path[--h];
+			int i=idx[h];
+			if (i>0&&p->son[i-1]->n>B/2) {
+				borrowLeft(p,i);
+				return;
+			}
+			if (i<p->n&&p->son[i+1]->n>B/2) {
+				borrowRight(p,i);
+				return;
+			}
+			mergeSons(p,i>0?i-1:i);
+			cur=p;
+		}
+		// cur is the root
+		if (cur->n>0) return;
+		if (cur->isLeaf) {
+			root=NULL;
+			front=rear=NULL;
+		} else {
+			root=static_cast<inner *>(cur)->son[0];
+		}
+		release(cur);
+	}
+
+public:
+    class Iterator
+    {
+		// (cur, pos) is the position next() returns; the iteration ends on
+		// reaching (stop, stopPos) or running off the leaves
+		leaf *cur, *stop;
+		int pos, stopPos;
+		bool desc;
+		Entry e;
+    public:
+		Iterator(leaf *cur, int pos, leaf *stop, int stopPos, bool desc) : cur(cur), stop(stop), pos(pos), stopPos(stopPos), desc(desc) {}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        bool hasNext() {
+			return cur!=NULL&&(cur!=stop||pos!=stopPos);
+		}
+
+        /**
+         * Returns the next element in the iteration. The reference is valid
+         * until the next call.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        const Entry &next() {
+			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
+			e=Entry(cur->keys[pos],cur->vals[pos]);
+			if (desc) {
+				if (--pos<0) {
+					cur=cur->pre;
+					pos=(cur==NULL?0:cur->n-1);
+				}
+			} else if (++pos==cur->n) {
+				cur=cur->next;
+				pos=0;
+			}
+			return e;
+		}
+    };
+
+    /**
+     * Constructs an empty map.
+     */
+    BTreeMap() : root(NULL), front(NULL), rear(NULL), Size(0) {}
+
+    /**
+     * Destructor
+     */
+    ~BTreeMap() {
+		if (root!=NULL) destroy(root);
+	}
+
+    /**
+     * Assignment operator
+     */
+    BTreeMap &operator=(const BTreeMap &x) {
+		if (this!=&x) {
+			if (root!=NULL) destroy(root);
+			copyFrom(x);
+		}
+		return *this;
+	}
+
+    /**
+     * Copy-constructor
+     */
+    BTreeMap(const BTreeMap &x) {
+		copyFrom(x);
+	}
+
+    /**
+     * Returns an iterator over the elements in this map in ascending key
+     * order.
+     */
+    Iterator iterator() const {
+		return Iterator(front,0,NULL,0,false);
+	}
+
+    /**
+     * Returns an iterator over the mappings whose keys lie in [from, to), in
+     * ascending order.
+     */
+    Iterator iterator(const K &from, const K &to) const {
+		if (!(from<to)) return Iterator(NULL,0,NULL,0,false);
+		leaf *l, *r;
+		int lp, rp;
+		seek(from,false,l,lp);
+		seek(to,false,r,rp);
+		return Iterator(l,lp,r,rp,false);
+	}
+
+    /**
+     * Returns an iterator over the elements in this map in descending key
+     * order.
+     */
+    Iterator descendingIterator() const {
+		return Iterator(rear,rear==NULL?0:rear->n-1,NULL,0,true);
+	}
+
+    /**
+     * Removes all of the mappings from this map.
+     */
+    void clear() {
+		if (root!=NULL) destroy(root);
+		root=NULL;
+		front=rear=NULL;
+		Size=0;
+	}
+
+    /**
+     * Returns true if this map contains a mapping for the specified key.
+     */
+    bool containsKey(const K &key) const {
+		int pos;
+		return find(key,pos)!=NULL;
+	}
+
+    /**
+     * Returns true if this map maps one or more keys to the specified value.
+     */
+    bool containsValue(const V &value) const {
+		for (leaf *l=front; l!=NULL; l=l->next) {
+			for (int i=0; i<l->n; ++i) {
+				if (l->vals[i]==value) return true;
+			}
+		}
+		return false;
+	}
+
+    /**
+     * Returns a const reference to the value to which the specified key is mapped.
+     * @throw ElementNotExist
+     */
+    const V &get(const K &key) const {
+		int pos;
+		leaf *l=find(key,pos);
+		if (l==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return l->vals[pos];
+	}
+
+    /**
+     * Returns true if this map contains no key-value mappings.
+     */
+    bool isEmpty() const {
+		return Size==0;
+	}
+
+    /**
+     * Associates the specified value with the specified key in this map.
+     */
+    void put(const K &key, const V &value) {
+		insert(key,value);
+	}
+
+    /**
+     * Removes the mapping for the specified key from this map if present.
+     * @throw ElementNotExist
+     */
+    void remove(const K &key) {
+		del(key);
+	}
+
+    /**
+     * Returns the least key in this map.
+     * @throw ElementNotExist if the map is empty
+     */
+    K firstKey() const {
+		return keyAt(front,0);
+	}
+
+    /**
+     * Returns the greatest key in this map.
+     * @throw ElementNotExist if the map is empty
+     */
+    K lastKey() const {
+		return keyAt(rear,rear==NULL?0:rear->n-1);
+	}
+
+    /**
+     * Returns the greatest key less than or equal to key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K floorKey(const K &key) const {
+		leaf *l;
+		int pos;
+		seek(key,true,l,pos);
+		stepBack(l,pos);
+		return keyAt(l,pos);
+	}
+
+    /**
+     * Returns the least key greater than or equal to key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K ceilingKey(const K &key) const {
+		leaf *l;
+		int pos;
+		seek(key,false,l,pos);
+		return keyAt(l,pos);
+	}
+
+    /**
+     * Returns the greatest key strictly less than key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K lowerKey(const K &key) const {
+		leaf *l;
+		int pos;
+		seek(key,false,l,pos);
+		stepBack(l,pos);
+		return keyAt(l,pos);
+	}
+
+    /**
+     * Returns the least key strictly greater than key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K higherKey(const K &key) const {
+		leaf *l;
+		int pos;
+		seek(key,true,l,pos);
+		return keyAt(l,pos);
+	}
+
+    /**
+     * Returns the number of key-value mappings in this map.
+     */
+    int size() const {
+		return Size;
+	}
+};
+
+#endif
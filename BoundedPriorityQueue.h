@@ -0,0 +1,197 @@
+/** @file */
+#ifndef __BOUNDEDPRIORITYQUEUE_H
+#define __BOUNDEDPRIORITYQUEUE_H
+
+#include "PriorityQueue.h"
+#include "ArrayList.h"
+#include "ElementNotExist.h"
+
+/**
+ * A priority queue that keeps only the k greatest elements offered to it
+ * (with respect to the Comparator C, used as in PriorityQueue), which makes
+ * it a streaming top-k selector. The front is the least element kept, that
+ * is the one the next better element will replace.
+ *
+ * offer() rejects an element that is not better than front() with a single
+ * comparison, and otherwise does at most one sift. Instances share nothing,
+ * so per-thread queues can be filled in parallel and combined at the end
+ * with mergeFrom().
+ *
+ * The iterator does not return the elements in any particular order.
+ */
+template <class V, class C = Less<V> >
+class BoundedPriorityQueue
+{
+	ArrayList<V> data;
+	int k;
+	C cmp;
+
+	void siftUp(int i) {
+		V x=data.elem[i];
+		while (i) {
+			int p=(i-1)>>1;
+			if (!cmp(x,data.elem[p])) break;
+			data.elem[i]=data.elem[p];
+			i=p;
+		}
+		data.elem[i]=x;
+	}
+
+	void siftDown(int i) {
+		V x=data.elem[i];
+		int n=data.Size;
+		while (i*2+1<n) {
+			int c=i*2+1;
+			if (c+1<n&&cmp(data.elem[c+1],data.elem[c])) ++c;
+			if (!cmp(data.elem[c],x)) break;
+			data.elem[i]=data.elem[c];
+			i=c;
+		}
+		data.elem[i]=x;
+	}
+
+public:
+    class Iterator
+    {
+		const BoundedPriorityQueue *a;
+		int pos;
+    public:
+		Iterator(const BoundedPriorityQueue *x) : a(x), pos(0) {}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        bool hasNext() {
+			return pos<a->data.Size;
+		}
+
+        /**
+         * Returns the next element in the iteration.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        const V &next() {
+			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
+			return a->data.elem[pos++];
+		}
+    };
+
+    /**
+     * Constructs an empty queue keeping at most k elements.
+     */
+    explicit BoundedPriorityQueue(int k) : k(k) {}
+
+    /**
+     * Returns an iterator over the elements in this queue.
+     */
+    Iterator iterator() const {
+		return Iterator(this);
+	}
+
+    /**
+     * Returns the maximum number of elements kept.
+     */
+    int capacity() const {
+		return k;
+	}
+
+    /**
+     * Removes all of the elements from this queue.
+     */
+    void clear() {
+		data.clear();
+	}
+
+    /**
+     * Returns a const reference to the least element kept.
+     * @throw ElementNotExist
+     */
+    const V &front() const {
+		if (data.Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		return data.elem[0];
+	}
+
+    /**
+     * Returns true if this queue contains no elements.
+     */
+    bool empty() const {
+		return data.Size==0;
+	}
+
+    /**
+     * Returns true if this queue holds k elements.
+     */
+    bool full() const {
+		return data.Size>=k;
+	}
+
+    /**
+     * Offers an element. While the queue is not full it is always kept;
+     * afterwards it replaces front() only if it is greater.
+     * Returns true if the element was kept.
+     */
+    bool offer(const V &value) {
+		if (data.Size<k) {
+			data.add(value);
+			siftUp(data.Size-1);
+			return true;
+		}
+		if (k<=0||!cmp(data.elem[0],value)) return false;
+		data.elem[0]=value;
+		siftDown(0);
+		return true;
+	}
+
+    /**
+     * Replaces front() with value, whatever its order, with a single
+     * sift-down.
+     * @throw ElementNotExist
+     */
+    void replaceTop(const V &value) {
+		if (data.Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		data.elem[0]=value;
+		siftDown(0);
+	}
+
+    /**
+     * Removes the least element kept.
+     * @throw ElementNotExist
+     */
+    void pop() {
+		if (data.Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		data.elem[0]=data.elem[data.Size-1];
+		data.removeIndex(data.Size-1);
+		if (data.Size>0) siftDown(0);
+	}
+
+    /**
+     * Empties this queue into out, appending the elements from the greatest
+     * to the least. Returns the number of elements appended.
+     */
+    int sortedDrain(ArrayList<V> &out) {
+		int n=data.Size, base=out.Size;
+		for (int i=0; i<n; ++i) out.add(data.elem[0]);
+		for (int i=n-1; i>=0; --i) {
+			out.elem[base+i]=data.elem[0];
+			pop();
+		}
+		return n;
+	}
+
+    /**
+     * Offers every element of other to this queue, leaving other unchanged.
+     * Merging a queue into itself does nothing.
+     */
+    void mergeFrom(const BoundedPriorityQueue &other) {
+		if (&other==this) return;
+		for (int i=0; i<other.data.Size; ++i) offer(other.data.elem[i]);
+	}
+
+    /**
+     * Returns the number of elements in this queue.
+     */
+    int size() const {
+		return data.Size;
+	}
+};
+
+#endif
@@ -0,0 +1,656 @@
+/** @file */
+#ifndef __CONCURRENTSKIPLISTMAP_H
+#define __CONCURRENTSKIPLISTMAP_H
+
+#include "ElementNotExist.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A sorted map that many threads may use at once, with the interface of
+ * TreeMap (put, get, remove, containsKey, the range queries and ordered
+ * iterators). Requires C++11.
+ *
+ * It is a lock-free skip list (Herlihy and Shavit), with the low bit of a
+ * node's next pointer at each level used as its deletion mark. Lookups never
+ * write. put links a new node with one CAS per level, and replacing a value
+ * swaps it atomically. remove first clears the node's value, which is the
+ * point where the key leaves the map, then marks the node's levels, and
+ * later traversals unlink it.
+ *
+ * Unlinked nodes and replaced values are reclaimed by epochs. Every
+ * operation announces the current epoch in a slot for its duration. Garbage
+ * is stamped with the epoch at which it was retired and freed once no slot
+ * announces that epoch or an earlier one. A node being linked into its upper
+ * levels while another thread removes it is retired by whichever of the two
+ * finishes last.
+ *
+ * get() returns a copy of the value, since the stored value may be replaced
+ * and freed right after the call. Iterators are weakly consistent: they never
+ * fail because of concurrent writes, and they return each key at most once,
+ * reflecting the map at some point at or after their creation. A live
+ * iterator holds back reclamation, so it should not be kept for long. The
+ * iterator needs K and V to be default-constructible.
+ */
+template <class K, class V>
+class ConcurrentSkipListMap
+{
+public:
+    class Entry
+    {
+        K key;
+        V value;
+    public:
+        Entry() {}
+
+        Entry(K k, V v)
+        {
+            key = k;
+            value = v;
+        }
+
+        K getKey() const
+        {
+            return key;
+        }
+
+        V getValue() const
+        {
+            return value;
+        }
+    };
+
+private:
+	const static int MAXLEVEL=16;
+	const static int NSLOTS=64;
+
+	struct garbage {
+		garbage *rnext;
+		unsigned long epoch;
+		virtual ~garbage() {}
+	};
+	struct box : garbage {
+		V data;
+		box(const V &data) : data(data) {}
+	};
+	// the head is a bare link; every other link is a node
+	struct link : garbage {
+		int level;
+		std::atomic<uintptr_t> *next;
+		link(int level) : level(level), next(new std::atomic<uintptr_t>[level]) {
+			for (int i=0; i<level; ++i) next[i].store(0,std::memory_order_relaxed);
+		}
+		~link() {
+			delete []next;
+		}
+	};
+	struct node : link {
+		K key;
+		std::atomic<box *> value;
+		// the inserter and the remover; the last one to let go retires the node
+		std::atomic<int> owners;
+		node(const K &key, box *value, int level) : link(level), key(key), value(value), owners(2) {}
+	};
+	struct alignas(64) slot {
+		std::atomic<unsigned long> epoch;
+	};
+
+	link *head;
+	std::atomic<int> Size;
+	mutable slot slots[NSLOTS];
+	mutable std::atomic<unsigned long> epoch;
+	// operations that found every slot taken; while any runs, nothing is freed
+	mutable std::atomic<int> overflow;
+	std::atomic<garbage *> retired;
+	std::atomic<int> retiredCount, threshold;
+	std::atomic_flag reclaiming;
+
+	static node *ptr(uintptr_t x) {
+		return reinterpret_cast<node *>(x&~(uintptr_t)1);
+	}
+
+	static bool marked(uintptr_t x) {
+		return (x&1)!=0;
+	}
+
+	static int threadHint() {
+		static thread_local char marker;
+		return (int)(((uintptr_t)&marker>>6)%NSLOTS);
+	}
+
+	static int randomLevel() {
+		static thread_local unsigned long long s=0;
+		if (s==0) s=(unsigned long long)(uintptr_t)&s*0x9E3779B97F4A7C15ULL|1;
+		s^=s<<13;
+		s^=s>>7;
+		s^=s<<17;
+		int lv=1;
+		for (unsigned long long r=s; lv<MAXLEVEL&&(r&3)==0; r>>=2) ++lv;
+		return lv;
+	}
+
+	/**
+	 * Announces epoch e, which must not be newer than the epoch of any
+	 * guard whose pointers the caller carries over, and returns the slot.
+	 */
+	int enter(unsigned long e) const {
+		int start=threadHint(), res=-1;
+		for (int i=0; i<NSLOTS&&res<0; ++i) {
+			int s=(start+i)%NSLOTS;
+			unsigned long z=0;
+			if (slots[s].epoch.compare_exchange_strong(z,e)) res=s;
+		}
+		if (res<0) overflow.fetch_add(1);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return res;
+	}
+
+	void leave(int s) const {
+		if (s<0) {
+			overflow.fetch_sub(1);
+		} else {
+			slots[s].epoch.store(0,std::memory_order_release);
+		}
+	}
+
+	/**
+	 * Announces an epoch for its lifetime, so that nothing the holder can
+	 * reach is freed. A copy announces the same epoch as the original, so
+	 * pointers found under the original stay safe under the copy.
+	 */
+	class Guard
+	{
+		const ConcurrentSkipListMap *m;
+		unsigned long e;
+		int s;
+	public:
+		Guard(const ConcurrentSkipListMap *m) : m(m), e(m->epoch.load()), s(m->enter(e)) {}
+		Guard(const Guard &x) : m(x.m), e(x.e), s(m->enter(e)) {}
+		Guard &operator=(const Guard &x) {
+			if (this!=&x) {
+				int tmp=x.m->enter(x.e);
+				m->leave(s);
+				m=x.m;
+				e=x.e;
+				s=tmp;
+			}
+			return *this;
+		}
+		~Guard() {
+			m->leave(s);
+		}
+	};
+
+	void retire(garbage *g) {
+		g->epoch=epoch.load();
+		g->rnext=retired.load(std::memory_order_relaxed);
+		while (!retired.compare_exchange_weak(g->rnext,g)) {}
+		if (retiredCount.fetch_add(1)+1>=threshold.load(std::memory_order_relaxed)) reclaim();
+	}
+
+	/**
+	 * Frees the garbage no announced epoch can still reach. Only one thread
+	 * reclaims at a time; the others skip it.
+	 */
+	void reclaim() {
+		if (reclaiming.test_and_set(std::memory_order_acquire)) return;
+		epoch.fetch_add(1);
+		garbage *list=retired.exchange(NULL);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		unsigned long low=~0UL;
+		for (int i=0; i<NSLOTS; ++i) {
+			unsigned long e=slots[i].epoch.load();
+			if (e!=0&&e<low) low=e;
+		}
+		bool pinned=overflow.load()>0;
+		garbage *keep=NULL, *last=NULL;
+		int kept=0, freed=0;
+		while (list!=NULL) {
+			garbage *tmp=list->rnext;
+			if (!pinned&&list->epoch<low) {
+				delete list;
+				++freed;
+			} else {
+				list->rnext=keep;
+				if (keep==NULL) last=list;
+				keep=list;
+				++kept;
+			}
+			list=tmp;
+		}
+		if (keep!=NULL) {
+			last->rnext=retired.load(std::memory_order_relaxed);
+			while (!retired.compare_exchange_weak(last->rnext,keep)) {}
+		}
+		retiredCount.fetch_sub(freed);
+		threshold.store(2*kept+64,std::memory_order_relaxed);
+		reclaiming.clear(std::memory_order_release);
+	}
+
+	/**
+	 * Fills preds and succs with the nodes around key at every level,
+	 * unlinking marked nodes on the way, and returns true if succs[0] holds
+	 * key. With through set it walks past the nodes holding key as well, so
+	 * that a removed node is unlinked even where a newer node with the same
+	 * key was linked in front of it. Must be called under a Guard.
+	 */
+	bool find(const K &key, link **preds, node **succs, bool through=false) {
+		for (;;) {
+			bool retry=false;
+			link *pred=head;
+			for (int i=MAXLEVEL-1; i>=0&&!retry; --i) {
+				node *curr=ptr(pred->next[i].load(std::memory_order_acquire));
+				while (curr!=NULL) {
+					uintptr_t succ=curr->next[i].load(std::memory_order_acquire);
+					if (marked(succ)) {
+						uintptr_t exp=(uintptr_t)curr;
+						if (!pred->next[i].compare_exchange_strong(exp,succ&~(uintptr_t)1)) {
+							retry=true;
+							break;
+						}
+						curr=ptr(succ);
+					} else if (curr->key<key||(through&&!(key<curr->key))) {
+						pred=curr;
+						curr=ptr(succ);
+					} else {
+						break;
+					}
+				}
+				preds[i]=pred;
+				succs[i]=curr;
+			}
+			if (!retry) return succs[0]!=NULL&&!(key<succs[0]->key);
+		}
+	}
+
+	/**
+	 * Returns the last link whose key is less than key (not greater if
+	 * inclusive), or the head. A NULL key stands for +infinity. Read-only;
+	 * must be called under a Guard.
+	 */
+	link *lastBefore(const K *key, bool inclusive) const {
+		link *pred=head;
+		for (int i=MAXLEVEL-1; i>=0; --i) {
+			node *curr=ptr(pred->next[i].load(std::memory_order_acquire));
+			while (curr!=NULL) {
+				uintptr_t succ=curr->next[i].load(std::memory_order_acquire);
+				if (!marked(succ)&&(key==NULL||(inclusive?!(*key<curr->key):curr->key<*key))) pred=curr;
+				else if (!marked(succ)) break;
+				curr=ptr(succ);
+			}
+		}
+		return pred;
+	}
+
+	static node *firstLiveAfter(link *pred) {
+		node *curr=ptr(pred->next[0].load(std::memory_order_acquire));
+		while (curr!=NULL&&curr->value.load(std::memory_order_acquire)==NULL) curr=ptr(curr->next[0].load(std::memory_order_acquire));
+		return curr;
+	}
+
+	/**
+	 * Returns the live node with the least key not less than key (greater if
+	 * strict), or NULL. Nodes with smaller keys may have been linked after
+	 * the one lastBefore returned, so they are skipped here.
+	 */
+	node *ceilNode(const K &key, bool strict) const {
+		node *curr=firstLiveAfter(lastBefore(&key,strict));
+		while (curr!=NULL&&(strict?!(key<curr->key):curr->key<key)) curr=firstLiveAfter(curr);
+		return curr;
+	}
+
+	/**
+	 * Returns the live node with the greatest key not greater than key (less
+	 * if strict), or NULL. A NULL key stands for +infinity.
+	 */
+	node *floorNode(const K *key, bool strict) const {
+		link *p=lastBefore(key,!strict);
+		while (p!=head&&static_cast<node *>(p)->value.load(std::memory_order_acquire)==NULL) {
+			p=lastBefore(&static_cast<node *>(p)->key,false);
+		}
+		return p==head?NULL:static_cast<node *>(p);
+	}
+
+	static K keyOf(node *cur) {
+		if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return cur->key;
+	}
+
+	static void markAll(node *x) {
+		for (int i=x->level-1; i>=0; --i) x->next[i].fetch_or(1);
+	}
+
+	/**
+	 * Lets go of x as its inserter or remover; the last one makes sure it
+	 * is unlinked at every level and retires it.
+	 */
+	void letGo(node *x) {
+		if (x->owners.fetch_sub(1)!=1) return;
+		link *preds[MAXLEVEL];
+		node *succs[MAXLEVEL];
+		find(x->key,preds,succs,true);
+		retire(x);
+	}
+
+	/**
+	 * Links x, already linked at level 0, into its upper levels. Gives up
+	 * as soon as x is being removed.
+	 */
+	void linkUpper(node *x, link **preds, node **succs) {
+		for (int i=1; i<x->level; ++i) {
+			for (;;) {
+				uintptr_t nx=x->next[i].load();
+				if (marked(nx)) return;
+				if (nx!=(uintptr_t)succs[i]&&!x->next[i].compare_exchange_strong(nx,(uintptr_t)succs[i])) return;
+				uintptr_t exp=(uintptr_t)succs[i];
+				if (preds[i]->next[i].compare_exchange_strong(exp,(uintptr_t)x)) break;
+				find(x->key,preds,succs);
+				if (succs[0]!=x) return;
+			}
+		}
+	}
+
+	/**
+	 * Removes key if present and returns true if this call removed it.
+	 * Must be called under a Guard.
+	 */
+	bool erase(const K &key) {
+		link *preds[MAXLEVEL];
+		node *succs[MAXLEVEL];
+		if (!find(key,preds,succs)) return false;
+		node *x=succs[0];
+		box *old=x->value.load();
+		do {
+			if (old==NULL) return false;
+		} while (!x->value.compare_exchange_weak(old,NULL));
+		Size.fetch_sub(1);
+		retire(old);
+		markAll(x);
+		letGo(x);
+		return true;
+	}
+
+	ConcurrentSkipListMap(const ConcurrentSkipListMap &);
+	ConcurrentSkipListMap &operator=(const ConcurrentSkipListMap &);
+
+public:
+    class Iterator
+    {
+		Guard g;
+		ConcurrentSkipListMap *a;
+		// the candidate for next(), possibly removed since it was found
+		node *nxt;
+		// exclusive upper bound of an ascending range, or NULL
+		K *to;
+		bool desc;
+		Entry e;
+
+		void advance() {
+			nxt=desc?a->floorNode(&nxt->key,true):ptr(nxt->next[0].load(std::memory_order_acquire));
+		}
+
+    public:
+		Iterator(const Guard &g, ConcurrentSkipListMap *a, node *nxt, const K *to, bool desc) : g(g), a(a), nxt(nxt), to(to==NULL?NULL:new K(*to)), desc(desc) {}
+
+		Iterator(const Iterator &x) : g(x.g), a(x.a), nxt(x.nxt), to(x.to==NULL?NULL:new K(*x.to)), desc(x.desc), e(x.e) {}
+
+		Iterator &operator=(const Iterator &x) {
+			if (this!=&x) {
+				g=x.g;
+				a=x.a;
+				nxt=x.nxt;
+				delete to;
+				to=(x.to==NULL?NULL:new K(*x.to));
+				desc=x.desc;
+				e=x.e;
+			}
+			return *this;
+		}
+
+		~Iterator() {
+			delete to;
+		}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        bool hasNext() {
+			while (nxt!=NULL&&nxt->value.load(std::memory_order_acquire)==NULL) advance();
+			if (nxt!=NULL&&to!=NULL&&!(nxt->key<*to)) nxt=NULL;
+			return nxt!=NULL;
+		}
+
+        /**
+         * Returns the next element in the iteration. The reference is valid
+         * until the next call.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        const Entry &next() {
+			box *b=NULL;
+			while (b==NULL) {
+				if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
+				b=nxt->value.load(std::memory_order_acquire);
+			}
+			e=Entry(nxt->key,b->data);
+			advance();
+			return e;
+		}
+    };
+
+    /**
+     * Constructs an empty map.
+     */
+    ConcurrentSkipListMap() : head(new link(MAXLEVEL)), Size(0), epoch(1), overflow(0), retired(NULL), retiredCount(0), threshold(64) {
+		for (int i=0; i<NSLOTS; ++i) slots[i].epoch.store(0);
+		reclaiming.clear();
+	}
+
+    /**
+     * Destructor. No other thread may be using the map.
+     */
+    ~ConcurrentSkipListMap() {
+		node *cur=ptr(head->next[0].load());
+		while (cur!=NULL) {
+			node *tmp=ptr(cur->next[0].load());
+			delete cur->value.load();
+			delete cur;
+			cur=tmp;
+		}
+		garbage *g=retired.load();
+		while (g!=NULL) {
+			garbage *tmp=g->rnext;
+			delete g;
+			g=tmp;
+		}
+		delete head;
+	}
+
+    /**
+     * Returns a weakly consistent iterator over the map in ascending key
+     * order.
+     */
+    Iterator iterator() {
+		Guard g(this);
+		return Iterator(g,this,firstLiveAfter(head),NULL,false);
+	}
+
+    /**
+     * Returns a weakly consistent iterator over the mappings whose keys lie
+     * in [from, to), in ascending order, after an O(log n) seek.
+     */
+    Iterator iterator(const K &from, const K &to) {
+		Guard g(this);
+		return Iterator(g,this,from<to?ceilNode(from,false):NULL,&to,false);
+	}
+
+    /**
+     * Returns a weakly consistent iterator over the map in descending key
+     * order. Each step is an O(log n) search.
+     */
+    Iterator descendingIterator() {
+		Guard g(this);
+		return Iterator(g,this,floorNode(NULL,false),NULL,true);
+	}
+
+    /**
+     * Removes all of the mappings present when each is reached.
+     */
+    void clear() {
+		Guard g(this);
+		for (node *cur=firstLiveAfter(head); cur!=NULL; cur=firstLiveAfter(head)) erase(cur->key);
+	}
+
+    /**
+     * Returns true if this map contains a mapping for the specified key.
+     */
+    bool containsKey(const K &key) const {
+		Guard g(this);
+		node *cur=ceilNode(key,false);
+		return cur!=NULL&&!(key<cur->key);
+	}
+
+    /**
+     * Returns true if this map maps one or more keys to the specified value.
+     */
+    bool containsValue(const V &value) const {
+		Guard g(this);
+		for (node *cur=firstLiveAfter(head); cur!=NULL; cur=firstLiveAfter(cur)) {
+			box *b=cur->value.load(std::memory_order_acquire);
+			if (b!=NULL&&b->data==value) return true;
+		}
+		return false;
+	}
+
+    /**
+     * Returns a copy of the value to which the specified key is mapped.
+     * @throw ElementNotExist
+     */
+    V get(const K &key) const {
+		Guard g(this);
+		link *p=lastBefore(&key,false);
+		for (node *cur=ptr(p->next[0].load(std::memory_order_acquire)); cur!=NULL&&!(key<cur->key); cur=ptr(cur->next[0].load(std::memory_order_acquire))) {
+			box *b=cur->value.load(std::memory_order_acquire);
+			if (b!=NULL&&!(cur->key<key)) return b->data;
+		}
+		throw ElementNotExist("\nElement Not Exist\n");
+	}
+
+    /**
+     * Returns true if this map contains no key-value mappings.
+     */
+    bool isEmpty() const {
+		Guard g(this);
+		return firstLiveAfter(head)==NULL;
+	}
+
+    /**
+     * Associates the specified value with the specified key in this map.
+     */
+    void put(const K &key, const V &value) {
+		Guard g(this);
+		box *b=new box(value);
+		link *preds[MAXLEVEL];
+		node *succs[MAXLEVEL];
+		for (;;) {
+			if (find(key,preds,succs)) {
+				node *x=succs[0];
+				box *old=x->value.load();
+				while (old!=NULL) {
+					if (x->value.compare_exchange_weak(old,b)) {
+						retire(old);
+						return;
+					}
+				}
+				// x is being removed: finish marking it so find unlinks it
+				markAll(x);
+				continue;
+			}
+			node *x=new node(key,b,randomLevel());
+			for (int i=0; i<x->level; ++i) x->next[i].store((uintptr_t)succs[i],std::memory_order_relaxed);
+			Size.fetch_add(1);
+			uintptr_t exp=(uintptr_t)succs[0];
+			if (!preds[0]->next[0].compare_exchange_strong(exp,(uintptr_t)x)) {
+				Size.fetch_sub(1);
+				delete x;
+				continue;
+			}
+			linkUpper(x,preds,succs);
+			letGo(x);
+			return;
+		}
+	}
+
+    /**
+     * Removes the mapping for the specified key from this map if present.
+     * @throw ElementNotExist
+     */
+    void remove(const K &key) {
+		Guard g(this);
+		if (!erase(key)) throw ElementNotExist("\nElement Not Exist\n");
+	}
+
+    /**
+     * Returns the least key in this map.
+     * @throw ElementNotExist if the map is empty
+     */
+    K firstKey() const {
+		Guard g(this);
+		return keyOf(firstLiveAfter(head));
+	}
+
+    /**
+     * Returns the greatest key in this map.
+     * @throw ElementNotExist if the map is empty
+     */
+    K lastKey() const {
+		Guard g(this);
+		return keyOf(floorNode(NULL,false));
+	}
+
+    /**
+     * Returns the greatest key less than or equal to key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K floorKey(const K &key) const {
+		Guard g(this);
+		return keyOf(floorNode(&key,false));
+	}
+
+    /**
+     * Returns the least key greater than or equal to key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K ceilingKey(const K &key) const {
+		Guard g(this);
+		return keyOf(ceilNode(key,false));
+	}
+
+    /**
+     * Returns the greatest key strictly less than key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K lowerKey(const K &key) const {
+		Guard g(this);
+		return keyOf(floorNode(&key,true));
+	}
+
+    /**
+     * Returns the least key strictly greater than key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K higherKey(const K &key) const {
+		Guard g(this);
+		return keyOf(ceilNode(key,true));
+	}
+
+    /**
+     * Returns the number of key-value mappings in this map. Under concurrent
+     * writes the count is only a snapshot.
+     */
+    int size() const {
+		return Size.load();
+	}
+};
+
+#endif
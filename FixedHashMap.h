@@ -0,0 +1,255 @@
+/** @file */
+#ifndef __FIXEDHASHMAP_H
+#define __FIXEDHASHMAP_H
+
+#include "ElementNotExist.h"
+#include <cstddef>
+
+#if __cplusplus >= 201402L
+#define FIXEDHASHMAP_CONSTEXPR constexpr
+#else
+#define FIXEDHASHMAP_CONSTEXPR
+#endif
+
+// a constructor leaving slots uninitialized can only be constexpr from C++20
+// on; for C++14 and C++17 the constexpr constructors value-initialize them
+#if __cplusplus >= 201402L
+#define FIXEDHASHMAP_CONSTEXPR_CTOR constexpr
+#else
+#define FIXEDHASHMAP_CONSTEXPR_CTOR
+#endif
+#if __cplusplus >= 201402L && __cplusplus < 202002L
+#define FIXEDHASHMAP_INIT_SLOTS
+#endif
+
+/**
+ * Rounds N up to a power of two at compile time.
+ */
+template <int N, int P = 1, bool Done = (P >= N)>
+struct RoundUpPow2
+{
+    enum { value = RoundUpPow2<N, P * 2>::value };
+};
+
+template <int N, int P>
+struct RoundUpPow2<N, P, true>
+{
+    enum { value = P };
+};
+
+/**
+ * FixedHashMap is a hash map holding at most N mappings whose storage lives
+ * entirely inside the object: it never allocates, and constructing or
+ * destroying one costs nothing beyond clearing a byte per slot, so it can be
+ * kept on the stack.
+ *
+ * The map uses open addressing with linear probing over a power-of-two number
+ * of slots (N*3/2+1 rounded up, so at least one slot is always empty and
+ * every probe ends), and backward-shift deletion, so no tombstones are left
+ * behind. H is the hash function, with the same requirements as in
+ * HashMap.
+ *
+ * Inserting into a full map does not throw: put() returns false instead.
+ * With C++14 every operation, construction included, is constexpr when K,
+ * V and H::hashCode are usable in constant expressions. Under C++14 and
+ * C++17 that makes the constructor value-initialize every slot; from C++20
+ * on it clears only the used flags again, as under C++98 and C++11.
+ */
+template <class K, class V, class H, int N>
+class FixedHashMap
+{
+public:
+    enum { SLOTS = RoundUpPow2<N + N / 2 + 1>::value };
+
+    class Entry
+    {
+        friend class FixedHashMap;
+        K key;
+        V value;
+    public:
+#ifdef FIXEDHASHMAP_INIT_SLOTS
+        FIXEDHASHMAP_CONSTEXPR_CTOR Entry() : key(), value() {}
+#else
+        FIXEDHASHMAP_CONSTEXPR_CTOR Entry() {}
+#endif
+
+        FIXEDHASHMAP_CONSTEXPR K getKey() const
+        {
+            return key;
+        }
+
+        FIXEDHASHMAP_CONSTEXPR V getValue() const
+        {
+            return value;
+        }
+    };
+
+private:
+	// compile-time check that a full map still has an empty slot
+	typedef char SlotsExceedN[SLOTS > N ? 1 : -1];
+
+	Entry slot[SLOTS];
+	bool used[SLOTS];
+	int Size;
+
+	static FIXEDHASHMAP_CONSTEXPR int home(const K &key) {
+		unsigned h=(unsigned)H::hashCode(key)*2654435769u;
+		return (h^(h>>16))&(SLOTS-1);
+	}
+
+	FIXEDHASHMAP_CONSTEXPR int find(const K &key) const {
+		for (int i=home(key); used[i]; i=(i+1)&(SLOTS-1)) {
+			if (slot[i].key==key) return i;
+		}
+		return -1;
+	}
+
+public:
+    class Iterator
+    {
+		const FixedHashMap *a;
+		int pos;
+
+    public:
+		FIXEDHASHMAP_CONSTEXPR Iterator(const FixedHashMap *a) : a(a), pos(-1) {}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        FIXEDHASHMAP_CONSTEXPR bool hasNext() const {
+			for (int i=pos+1; i<SLOTS; ++i) {
+				if (a->used[i]) return true;
+			}
+			return false;
+		}
+
+        /**
+         * Returns the next element in the iteration.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        FIXEDHASHMAP_CONSTEXPR const Entry &next() {
+			++pos;
+			while (pos<SLOTS&&!a->used[pos]) ++pos;
+			if (pos>=SLOTS) throw ElementNotExist("\nElement Not Exist\n");
+			return a->slot[pos];
+		}
+    };
+
+    /**
+     * Constructs an empty map.
+     */
+#ifdef FIXEDHASHMAP_INIT_SLOTS
+    FIXEDHASHMAP_CONSTEXPR_CTOR FixedHashMap() : slot(), used(), Size(0) {}
+#else
+    FIXEDHASHMAP_CONSTEXPR_CTOR FixedHashMap() : used(), Size(0) {}
+#endif
+
+    /**
+     * Returns the maximum number of mappings, N.
+     */
+    static FIXEDHASHMAP_CONSTEXPR int capacity() {
+		return N;
+	}
+
+    /**
+     * Returns an iterator over the elements in this map.
+     */
+    FIXEDHASHMAP_CONSTEXPR Iterator iterator() const {
+		return Iterator(this);
+	}
+
+    /**
+     * Removes all of the mappings from this map.
+     */
+    FIXEDHASHMAP_CONSTEXPR void clear() {
+		for (int i=0; i<SLOTS; ++i) used[i]=false;
+		Size=0;
+	}
+
+    /**
+     * Returns true if this map contains a mapping for the specified key.
+     */
+    FIXEDHASHMAP_CONSTEXPR bool containsKey(const K &key) const {
+		return find(key)>=0;
+	}
+
+    /**
+     * Returns a pointer to the value mapped to the specified key, or NULL if
+     * the key is not present.
+     */
+    FIXEDHASHMAP_CONSTEXPR const V *lookup(const K &key) const {
+		int i=find(key);
+		return i<0?NULL:&slot[i].value;
+	}
+
+    /**
+     * Returns a const reference to the value to which the specified key is mapped.
+     * If the key is not present in this map, this function should throw ElementNotExist exception.
+     * @throw ElementNotExist
+     */
+    FIXEDHASHMAP_CONSTEXPR const V &get(const K &key) const {
+		int i=find(key);
+		if (i<0) throw ElementNotExist("\nElement Not Exist\n");
+		return slot[i].value;
+	}
+
+    /**
+     * Returns true if this map contains no key-value mappings.
+     */
+    FIXEDHASHMAP_CONSTEXPR bool isEmpty() const {
+		return Size==0;
+	}
+
+    /**
+     * Associates the specified value with the specified key in this map.
+     * Returns false, leaving the map unchanged, if the key is new and the
+     * map already holds N mappings.
+     */
+    FIXEDHASHMAP_CONSTEXPR bool put(const K &key, const V &value) {
+		int i=home(key);
+		for (; used[i]; i=(i+1)&(SLOTS-1)) {
+			if (slot[i].key==key) {
+				slot[i].value=value;
+				return true;
+			}
+		}
+		if (Size>=N) return false;
+		slot[i].key=key;
+		slot[i].value=value;
+		used[i]=true;
+		++Size;
+		return true;
+	}
+
+    /**
+     * Removes the mapping for the specified key from this map if present.
+     * Returns true if there was such a mapping.
+     */
+    FIXEDHASHMAP_CONSTEXPR bool remove(const K &key) {
+		int i=find(key);
+		if (i<0) return false;
+		used[i]=false;
+		--Size;
+		// shift back every following entry of the cluster that may not sit
+		// beyond the new hole
+		for (int j=(i+1)&(SLOTS-1); used[j]; j=(j+1)&(SLOTS-1)) {
+			int h=home(slot[j].key);
+			if (i<=j?(h<=i||h>j):(h<=i&&h>j)) {
+				slot[i]=slot[j];
+				used[i]=true;
+				used[j]=false;
+				i=j;
+			}
+		}
+		return true;
+	}
+
+    /**
+     * Returns the number of key-value mappings in this map.
+     */
+    FIXEDHASHMAP_CONSTEXPR int size() const {
+		return Size;
+	}
+};
+
+#endif
@@ -4,7 +4,13 @@
 #define __HASHMAP_H
 
 #include "ElementNotExist.h"
+#include "IndexOutOfBound.h"
+#include "ArrayList.h"
 #include<ctime>
+#include <climits>
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
 
 /**
  * HashMap is a map implemented by hashing. Also, the 'capacity' here means the
@@ -80,7 +86,7 @@ public:
 		node(Entry data, node *next=NULL) : data(data), next(next) {}
 	};
 	const static int Omod=97;
-	const static double frac=0.80;
+	const static double frac;
 	int Mod;
 	int capa, Size;
 	node **elem;
@@ -89,40 +95,88 @@ public:
 		return (H::hashCode(key)%Mod+Mod)%Mod;
 	}
 
-	void rehash() {
+	/**
+	 * Moves every node into a table of newMod buckets. Nodes are relinked,
+	 * not reallocated.
+	 */
+	void resize(int newMod) {
 		node **e=elem;
 		int tmod=Mod;
-		Mod*=2;
+		Mod=newMod;
 		elem=new node *[Mod];
 		capa=Mod*frac;
 		for (int i=0; i<Mod; ++i) elem[i]=NULL;
-		for (int i=0; i<tmod; ++i) {
-			for (node *tmp=e[i]; tmp!=NULL; tmp=tmp->next) {
-				int index=hash(tmp->data.getKey());
-				node *cur=new node(tmp->data,elem[index]);
-				elem[index]=cur;
-			}
-		}
 		for (int i=0; i<tmod; ++i) {
 			node *cur=e[i];
 			while (cur!=NULL) {
 				node *tmp=cur->next;
-				delete cur;
+				int index=hash(cur->data.getKey());
+				cur->next=elem[index];
+				elem[index]=cur;
 				cur=tmp;
 			}
 		}
 		delete []e;
 	}
 
+	void rehash() {
+		resize(Mod*2);
+	}
+
+	/**
+	 * Returns the least bucket count, doubling from mod, whose capacity
+	 * holds n mappings.
+	 * @throw IndexOutOfBound if that many buckets would overflow an int
+	 */
+	static int bucketsFor(int mod, int n) {
+		while (int(mod*frac)<n) {
+			if (mod>INT_MAX/2) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+			mod*=2;
+		}
+		return mod;
+	}
+
+	/**
+	 * Puts (key, value) into the chain of bucket index without checking the
+	 * load factor. Returns true if a new node was created.
+	 */
+	bool insertAt(int index, const K &key, const V &value) {
+		for (node *tmp=elem[index]; tmp!=NULL; tmp=tmp->next) {
+			if (tmp->data.getKey()==key) {
+				tmp->data=Entry(key,value);
+				return false;
+			}
+		}
+		elem[index]=new node(Entry(key,value),elem[index]);
+		return true;
+	}
+
+#if __cplusplus >= 201103L
+	/**
+	 * Runs f(0), ..., f(threads-1) concurrently, f(0) on the calling thread.
+	 */
+	template <class F>
+	static void parallelFor(int threads, F f) {
+		std::thread *pool=new std::thread[threads];
+		for (int t=1; t<threads; ++t) pool[t]=std::thread(f,t);
+		f(0);
+		for (int t=1; t<threads; ++t) pool[t].join();
+		delete []pool;
+	}
+#endif
+
     class Iterator
     {
-		node **elem;
-		node *cur;
-		int idx,Mod;
+		HashMap *a;
+		// link: the pointer that refers to the next node of bucket idx to visit
+		// last: the pointer that refers to the node last returned by next()
+		node **link, **last;
+		int idx;
 
     public:
-		Iterator(node **elem, int Mod) : elem(elem), Mod(Mod) {
-			cur=NULL;
+		Iterator(HashMap *a) : a(a) {
+			link=NULL;
+			last=NULL;
 			idx=-1;
 		}
 
@@ -131,13 +185,10 @@ public:
          * TODO Returns true if the iteration has more elements.
          */
         bool hasNext() {
-			if (cur==NULL||cur->next==NULL) {
-				int i=idx+1;
-				while (i<Mod) {
-					if (elem[i]!=NULL) return 1;
-					++i;
-				}
-			} else return 1;
+			if (link!=NULL&&*link!=NULL) return 1;
+			for (int i=idx+1; i<a->Mod; ++i) {
+				if (a->elem[i]!=NULL) return 1;
+			}
 			return 0;
 		}
 
@@ -146,20 +197,57 @@ public:
          * @throw ElementNotExist exception when hasNext() == false
          */
         const Entry &next() {
-			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
-			if (cur==NULL||cur->next==NULL) {
+			if (link==NULL||*link==NULL) {
 				++idx;
-				while (idx<Mod) {
-					if (elem[idx]!=NULL) {
-						cur=elem[idx];
-						return cur->data;
-					}
-					++idx;
-				}
-			} else {
-				cur=cur->next;
+				while (idx<a->Mod&&a->elem[idx]==NULL) ++idx;
+				if (idx>=a->Mod) throw ElementNotExist("\nElement Not Exist\n");
+				link=&a->elem[idx];
 			}
-			return cur->data;
+			last=link;
+			link=&(*link)->next;
+			return (*last)->data;
+		}
+
+        /**
+         * Removes from the underlying map the last entry returned by the
+         * iterator, in O(1). The iteration stays valid.
+         * @throw ElementNotExist
+         */
+        void remove() {
+			if (last==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			node *tmp=*last;
+			*last=tmp->next;
+			link=last;
+			last=NULL;
+			delete tmp;
+			--a->Size;
+		}
+    };
+
+    /**
+     * Iterates a const map. It has no remove(), so a const HashMap cannot be
+     * changed through it.
+     */
+    class ConstIterator
+    {
+		Iterator it;
+
+    public:
+		ConstIterator(const HashMap *a) : it(const_cast<HashMap *>(a)) {}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        bool hasNext() {
+			return it.hasNext();
+		}
+
+        /**
+         * Returns the next element in the iteration.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        const Entry &next() {
+			return it.next();
 		}
     };
 
@@ -176,6 +264,21 @@ public:
 		}
 	}
 
+    /**
+     * Constructs an empty hash map with enough buckets to hold expectedSize
+     * mappings without rehashing.
+     * @throw IndexOutOfBound if expectedSize is too large
+     */
+    explicit HashMap(int expectedSize) {
+		Mod=bucketsFor(Omod,expectedSize);
+		capa=Mod*frac;
+		Size=0;
+		elem=new node *[Mod];
+		for (int i=0; i<Mod; ++i) {
+			elem[i]=NULL;
+		}
+	}
+
     /**
      * TODO Destructor
      */
@@ -242,8 +345,15 @@ public:
     /**
      * TODO Returns an iterator over the elements in this map.
      */
-    Iterator iterator() const {
-		return Iterator(elem,Mod);
+    Iterator iterator() {
+		return Iterator(this);
+	}
+
+    /**
+     * Returns a read-only iterator over the elements of a const map.
+     */
+    ConstIterator iterator() const {
+		return ConstIterator(this);
 	}
 
     /**
@@ -318,17 +428,86 @@ public:
      * TODO Associates the specified value with the specified key in this map.
      */
     void put(const K &key, const V &value) {
-		int index=hash(key);
-		for (node *tmp=elem[index]; tmp!=NULL; tmp=tmp->next) {
-			if (tmp->data.getKey()==key) {
-				tmp->data=Entry(key,value);
-				return;
+		if (insertAt(hash(key),key,value)) {
+			++Size;
+			if (Size>capa) rehash();
+		}
+	}
+
+    /**
+     * Grows the bucket array so that n mappings fit without further rehashing.
+     * @throw IndexOutOfBound if n is too large
+     */
+    void reserve(int n) {
+		int newMod=bucketsFor(Mod,n);
+		if (newMod!=Mod) resize(newMod);
+	}
+
+    /**
+     * Puts keys.get(i) -> values.get(i) for every i, in order, so a later
+     * duplicate key overrides an earlier one just as with repeated put().
+     * The table is grown once up front. With threads > 1 the input is
+     * partitioned by bucket range and each thread fills its own disjoint
+     * range of buckets, so no locking is needed (requires C++11; otherwise
+     * the load is sequential).
+     * @throw IndexOutOfBound if keys and values differ in size
+     */
+    void buildFrom(const ArrayList<K> &keys, const ArrayList<V> &values, int threads=1) {
+		if (keys.Size!=values.Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		int n=keys.Size;
+		reserve(Size+n);
+#if __cplusplus < 201103L
+		threads=1;
+#endif
+		if (threads>n/1024) threads=n/1024;
+		if (threads<=1) {
+			for (int i=0; i<n; ++i) {
+				if (insertAt(hash(keys.elem[i]),keys.elem[i],values.elem[i])) ++Size;
+			}
+			return;
+		}
+#if __cplusplus >= 201103L
+		int T=threads;
+		int *idx=new int[n];
+		int *order=new int[n];
+		// pos[c*T+r]: items of input chunk c that fall into bucket range r
+		int *pos=new int[T*T];
+		int *added=new int[T];
+		for (int i=0; i<T*T; ++i) pos[i]=0;
+		parallelFor(T,[&](int c) {
+			int lo=(long long)n*c/T, hi=(long long)n*(c+1)/T;
+			for (int i=lo; i<hi; ++i) {
+				idx[i]=hash(keys.elem[i]);
+				++pos[c*T+(long long)idx[i]*T/Mod];
+			}
+		});
+		int sum=0;
+		for (int r=0; r<T; ++r) {
+			for (int c=0; c<T; ++c) {
+				int tmp=pos[c*T+r];
+				pos[c*T+r]=sum;
+				sum+=tmp;
 			}
 		}
-		node *tmp=new node(Entry(key,value),elem[index]);
-		elem[index]=tmp;
-		++Size;
-		if (Size>capa) rehash();
+		parallelFor(T,[&](int c) {
+			int lo=(long long)n*c/T, hi=(long long)n*(c+1)/T;
+			for (int i=lo; i<hi; ++i) order[pos[c*T+(long long)idx[i]*T/Mod]++]=i;
+		});
+		// after scattering, range r ends where chunk T-1 of range r ended
+		parallelFor(T,[&](int r) {
+			int lo=(r==0?0:pos[(T-1)*T+r-1]), hi=pos[(T-1)*T+r];
+			added[r]=0;
+			for (int j=lo; j<hi; ++j) {
+				int i=order[j];
+				if (insertAt(idx[i],keys.elem[i],values.elem[i])) ++added[r];
+			}
+		});
+		for (int r=0; r<T; ++r) Size+=added[r];
+		delete []idx;
+		delete []order;
+		delete []pos;
+		delete []added;
+#endif
 	}
 
     /**
@@ -337,21 +516,40 @@ public:
      * @throw ElementNotExist
      */
     void remove(const K &key) {
-		int index=hash(key);
-		if (!containsKey(key)) throw ElementNotExist("\nElement Not Exist\n");
-		node *last=NULL;
-		for (node *tmp=elem[index]; tmp!=NULL; last=tmp, tmp=tmp->next) {
-			if (tmp->data.getKey()==key) {
-				if (last!=NULL) {
-					last->next=tmp->next;
-				} else {
-					elem[index]=tmp->next;
-				}
+		for (node **link=&elem[hash(key)]; *link!=NULL; link=&(*link)->next) {
+			if ((*link)->data.getKey()==key) {
+				node *tmp=*link;
+				*link=tmp->next;
 				--Size;
 				delete tmp;
 				return;
 			}
 		}
+		throw ElementNotExist("\nElement Not Exist\n");
+	}
+
+    /**
+     * Removes every mapping e for which pred(e) is true, in a single pass
+     * over the table. Returns the number of mappings removed.
+     */
+    template <class P>
+    int removeIf(P pred) {
+		int removed=0;
+		for (int i=0; i<Mod; ++i) {
+			node **link=&elem[i];
+			while (*link!=NULL) {
+				node *tmp=*link;
+				if (pred(static_cast<const Entry &>(tmp->data))) {
+					*link=tmp->next;
+					delete tmp;
+					++removed;
+				} else {
+					link=&tmp->next;
+				}
+			}
+		}
+		Size-=removed;
+		return removed;
 	}
 
     /**
@@ -362,4 +560,7 @@ public:
 	}
 };
 
+template <class K, class V, class H>
+const double HashMap<K,V,H>::frac=0.80;
+
 #endif
@@ -0,0 +1,355 @@
+/** @file */
+#ifndef __INDEXEDPRIORITYQUEUE_H
+#define __INDEXEDPRIORITYQUEUE_H
+
+#include "PriorityQueue.h"
+
+/**
+ * A PriorityQueue whose push() returns a Handle to the new element, through
+ * which it can later be looked up, updated (decrease- or increase-key) or
+ * removed in O(log n). V, C and D mean the same as in PriorityQueue.
+ *
+ * Keeping handles costs a handle slot per element, and every move of a sift
+ * also records the element's new index in its slot; queues that need no
+ * handles should use the plain PriorityQueue, whose heap stays compact.
+ */
+template <class V, class C = Less<V>, int D = 2>
+class IndexedPriorityQueue
+{
+public:
+    /**
+     * Identifies one element pushed into the queue, for update(), remove()
+     * and contains(). A handle stays valid until its element leaves the
+     * queue; after that, contains() reports false for it even if the slot
+     * has been reused.
+     */
+    class Handle
+    {
+		friend class IndexedPriorityQueue;
+		int id, ver;
+		Handle(int id, int ver) : id(id), ver(ver) {}
+    public:
+		Handle() : id(-1), ver(0) {}
+    };
+
+private:
+	typedef DaryHeap<V,C,D> Heap;
+
+	ArrayList<V> data;
+	// id.elem[i] is the handle slot of data.elem[i]; where.elem[k] is the heap
+	// index of slot k (-1 if free) and ver.elem[k] its current version
+	ArrayList<int> id, where, ver, freeIds;
+	C cmp;
+
+	/**
+	 * Carries the handle slots along with the elements a heap operation
+	 * moves, keeping id and where in step with data.
+	 */
+	struct Track {
+		IndexedPriorityQueue *q;
+		int lifted;
+		Track(IndexedPriorityQueue *q) : q(q), lifted(-1) {}
+		void moved(int from, int to) {
+			if (to==-1) {
+				lifted=q->id.elem[from];
+				return;
+			}
+			int k=(from==-1?lifted:q->id.elem[from]);
+			q->id.elem[to]=k;
+			q->where.elem[k]=to;
+		}
+	};
+
+	int newId() {
+		if (freeIds.Size>0) {
+			int k=freeIds.elem[freeIds.Size-1];
+			freeIds.removeIndex(freeIds.Size-1);
+			return k;
+		}
+		where.add(-1);
+		ver.add(0);
+		return where.Size-1;
+	}
+
+	void append(const V &value) {
+		int k=newId();
+		data.add(value);
+		id.add(k);
+		where.elem[k]=data.Size-1;
+	}
+
+	/**
+	 * Removes the element at i and frees its handle slot. Returns true if
+	 * the last element, moved into the hole, had to go above i, in which
+	 * case its handle slot is stored in moved.
+	 */
+	bool removeAt(int i, int &moved) {
+		int k=id.elem[i];
+		where.elem[k]=-1;
+		++ver.elem[k];
+		freeIds.add(k);
+		Track t(this);
+		int j=Heap::removeAt(data,cmp,i,t);
+		id.removeIndex(id.Size-1);
+		if (j==-1) return false;
+		moved=id.elem[j];
+		return true;
+	}
+
+	int indexOf(const Handle &h) const {
+		if (h.id<0||h.id>=where.Size||ver.elem[h.id]!=h.ver) throw ElementNotExist("\nElement Not Exist\n");
+		return where.elem[h.id];
+	}
+
+public:
+    class Iterator
+    {
+		IndexedPriorityQueue<V,C,D> *a;
+		// pos: next index to visit; last: index of the last returned element
+		int pos, last;
+		// handle slots of elements that a removal moved to an index already
+		// visited, and the slot of the last one returned (-1 if none)
+		ArrayList<int> forget;
+		int lastForgotten;
+
+    public:
+		Iterator(IndexedPriorityQueue<V,C,D> *x) {
+		   a=x;
+		   pos=0;
+		   last=-1;
+		   lastForgotten=-1;
+		}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        bool hasNext() {
+			return pos<a->data.Size||forget.Size>0;
+		}
+
+        /**
+         * Returns the next element in the iteration, in no particular order.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        const V &next() {
+			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
+			if (pos<a->data.Size) {
+				last=pos++;
+				return a->data.elem[last];
+			}
+			last=-1;
+			lastForgotten=forget.elem[forget.Size-1];
+			forget.removeIndex(forget.Size-1);
+			return a->data.elem[a->where.elem[lastForgotten]];
+		}
+
+		/**
+		 * Removes the last element returned by next() from the queue; its
+		 * handle goes stale. Every other element is still returned exactly
+		 * once. Modifying the queue any other way during the iteration
+		 * leaves the iterator unspecified.
+		 * @throw ElementNotExist if next() has not been called since the
+		 * last remove()
+		 */
+		void remove() {
+			int moved;
+			if (last!=-1) {
+				if (a->removeAt(last,moved)) {
+					forget.add(moved);
+				} else {
+					pos=last;
+				}
+				last=-1;
+			} else if (lastForgotten!=-1) {
+				a->removeAt(a->where.elem[lastForgotten],moved);
+				lastForgotten=-1;
+			} else {
+				throw ElementNotExist("\nElement Not Exist\n");
+			}
+		}
+    };
+
+    /**
+     * Constructs an empty queue.
+     */
+    IndexedPriorityQueue() {
+	}
+
+    /**
+     * Destroys the queue; every handle into it becomes meaningless.
+     */
+    ~IndexedPriorityQueue() {
+	}
+
+    /**
+     * Replaces the contents with a copy of x. Handles into x also identify
+     * the matching elements of the copy.
+     */
+    IndexedPriorityQueue &operator=(const IndexedPriorityQueue &x) {
+		if (this!=&x) {
+			data=x.data;
+			id=x.id;
+			where=x.where;
+			ver=x.ver;
+			freeIds=x.freeIds;
+		}
+		return *this;
+	}
+
+    /**
+     * Constructs a copy of x. Handles into x also identify the matching
+     * elements of the copy.
+     */
+    IndexedPriorityQueue(const IndexedPriorityQueue &x) {
+		data=x.data;
+		id=x.id;
+		where=x.where;
+		ver=x.ver;
+		freeIds=x.freeIds;
+	}
+
+	/**
+	 * Constructs a queue over the elements of x in O(n). No handles are
+	 * returned for them, so they can only be reached through the front or
+	 * the iterator.
+	 */
+	IndexedPriorityQueue(const ArrayList<V> &x) {
+		data=x;
+		for (int i=0; i<data.Size; ++i) {
+			id.add(i);
+			where.add(i);
+			ver.add(0);
+		}
+		Track t(this);
+		Heap::heapify(data,cmp,t);
+	}
+
+    /**
+     * Returns an iterator over the elements of the queue.
+     */
+    Iterator iterator() {
+		return Iterator(this);
+	}
+
+    /**
+     * Removes every element. Handle slots keep their versions, so handles
+     * from before the clear stay stale once their slots are reused.
+     */
+    void clear() {
+		data.clear();
+		id.clear();
+		freeIds.clear();
+		for (int k=where.Size-1; k>=0; --k) {
+			if (where.elem[k]!=-1) {
+				where.elem[k]=-1;
+				++ver.elem[k];
+			}
+			freeIds.add(k);
+		}
+	}
+
+    /**
+     * Returns a const reference to the least element.
+     * @throw ElementNotExist if the queue is empty
+     */
+    const V &front() const {
+		if (data.Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		return data.elem[0];
+	}
+
+    /**
+     * Returns true if the queue holds no elements.
+     */
+    bool empty() const {
+		return data.Size==0;
+	}
+
+    /**
+     * Adds value in O(log n) and returns the handle identifying it.
+     */
+    Handle push(const V &value) {
+		append(value);
+		Track t(this);
+		int k=id.elem[Heap::siftUp(data,cmp,data.Size-1,t)];
+		return Handle(k,ver.elem[k]);
+	}
+
+    /**
+     * Adds every element of x, as PriorityQueue::pushAll() does. No handles
+     * are returned for them.
+     */
+    void pushAll(const ArrayList<V> &x) {
+		for (int i=0; i<x.Size; ++i) append(x.elem[i]);
+		Track t(this);
+		Heap::appended(data,cmp,x.Size,t);
+	}
+
+    /**
+     * Removes the k smallest elements (all of them if there are fewer) and
+     * appends them to out in ascending order. Returns the number removed.
+     */
+    int popN(int k, ArrayList<V> &out) {
+		if (k>data.Size) k=data.Size;
+		int moved;
+		for (int i=0; i<k; ++i) {
+			out.add(data.elem[0]);
+			removeAt(0,moved);
+		}
+		return k<0?0:k;
+	}
+
+    /**
+     * Removes the least element; its handle goes stale.
+     * @throw ElementNotExist if the queue is empty
+     */
+    void pop() {
+		if (data.Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		int moved;
+		removeAt(0,moved);
+	}
+
+    /**
+     * Returns true if the element identified by h is still in this queue.
+     */
+    bool contains(const Handle &h) const {
+		return h.id>=0&&h.id<where.Size&&ver.elem[h.id]==h.ver;
+	}
+
+    /**
+     * Returns a const reference to the element identified by h.
+     * @throw ElementNotExist if it is no longer in this queue
+     */
+    const V &get(const Handle &h) const {
+		return data.elem[indexOf(h)];
+	}
+
+    /**
+     * Replaces the element identified by h with value and restores the heap
+     * order in O(log n). Works for both decreasing and increasing keys.
+     * @throw ElementNotExist if it is no longer in this queue
+     */
+    void update(const Handle &h, const V &value) {
+		int i=indexOf(h);
+		data.elem[i]=value;
+		Track t(this);
+		if (Heap::siftUp(data,cmp,i,t)==i) Heap::siftDown(data,cmp,i,t);
+	}
+
+    /**
+     * Removes the element identified by h in O(log n).
+     * @throw ElementNotExist if it is no longer in this queue
+     */
+    void remove(const Handle &h) {
+		int moved;
+		removeAt(indexOf(h),moved);
+	}
+
+    /**
+     * Returns the number of elements in the queue.
+     */
+    int size() const {
+		return data.Size;
+	}
+};
+
+#endif
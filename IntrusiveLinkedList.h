@@ -0,0 +1,296 @@
+/** @file */
+#ifndef __INTRUSIVELINKEDLIST_H
+#define __INTRUSIVELINKEDLIST_H
+
+#include "ElementNotExist.h"
+#include <cassert>
+#include <cstddef>
+
+/**
+ * The links an object needs to sit on an IntrusiveLinkedList. An object can
+ * be on several lists at once by having one hook per list.
+ * Copying an object does not copy its list membership: a copied hook starts
+ * unlinked, and assigning to a hook leaves it untouched.
+ */
+template <class T>
+class IntrusiveListHook
+{
+public:
+    T *pre, *next;
+    const void *list;
+
+    IntrusiveListHook() : pre(NULL), next(NULL), list(NULL) {}
+    IntrusiveListHook(const IntrusiveListHook &) : pre(NULL), next(NULL), list(NULL) {}
+    IntrusiveListHook &operator=(const IntrusiveListHook &) { return *this; }
+
+    /**
+     * Returns true if the owner is on some list through this hook.
+     */
+    bool isLinked() const {
+        return list!=NULL;
+    }
+};
+
+/**
+ * A doubly linked list of objects it does not own, linked through the
+ * IntrusiveListHook member Hook of T. The list never allocates or copies:
+ * add and remove only rewrite the hooks, and remove(e) is O(1).
+ *
+ * Every hook records which list it is on, so remove() and contains() can
+ * tell in O(1) whether an object is on this list. Linking an object that is
+ * already on a list through the same hook is a bug, caught by an assertion
+ * in debug builds. The objects must outlive their membership; destroying the
+ * list unlinks them all.
+ *
+ * The iterator iterates in list order.
+ */
+template <class T, IntrusiveListHook<T> T::*Hook>
+class IntrusiveLinkedList
+{
+	T *front, *rear;
+	int Size;
+
+	static IntrusiveListHook<T> &hook(T &e) {
+		return e.*Hook;
+	}
+
+	void linkBefore(T *pos, T &e) {
+		IntrusiveListHook<T> &h=hook(e);
+		assert(h.list==NULL);
+		h.list=this;
+		h.next=pos;
+		h.pre=(pos==NULL?rear:hook(*pos).pre);
+		if (h.pre!=NULL) {
+			hook(*h.pre).next=&e;
+		} else {
+			front=&e;
+		}
+		if (pos!=NULL) {
+			hook(*pos).pre=&e;
+		} else {
+			rear=&e;
+		}
+		++Size;
+	}
+
+	void unlink(T &e) {
+		IntrusiveListHook<T> &h=hook(e);
+		if (h.pre!=NULL) {
+			hook(*h.pre).next=h.next;
+		} else {
+			front=h.next;
+		}
+		if (h.next!=NULL) {
+			hook(*h.next).pre=h.pre;
+		} else {
+			rear=h.pre;
+		}
+		h.pre=h.next=NULL;
+		h.list=NULL;
+		--Size;
+	}
+
+	IntrusiveLinkedList(const IntrusiveLinkedList &);
+	IntrusiveLinkedList &operator=(const IntrusiveLinkedList &);
+
+public:
+    class Iterator
+    {
+		IntrusiveLinkedList *a;
+		T *pos, *last;
+		bool started;
+    public:
+		Iterator(IntrusiveLinkedList *x) : a(x), pos(NULL), last(NULL), started(false) {}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        bool hasNext() {
+			return started?pos!=NULL:a->front!=NULL;
+		}
+
+        /**
+         * Returns the next element in the iteration.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        T &next() {
+			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
+			if (!started) {
+				pos=a->front;
+				started=true;
+			}
+			last=pos;
+			pos=hook(*pos).next;
+			return *last;
+		}
+
+        /**
+         * Unlinks from the list the last element returned by the iterator.
+         * The element itself is not destroyed.
+         * @throw ElementNotExist
+         */
+        void remove() {
+			if (last==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			a->unlink(*last);
+			last=NULL;
+		}
+    };
+
+    /**
+     * Constructs an empty list
+     */
+    IntrusiveLinkedList() {
+		front=rear=NULL;
+		Size=0;
+	}
+
+    /**
+     * Destructor: unlinks every element.
+     */
+    ~IntrusiveLinkedList() {
+		clear();
+	}
+
+    /**
+     * Appends the specified element to the end of this list.
+     * Always returns true.
+     */
+    bool add(T &e) {
+		linkBefore(NULL,e);
+		return true;
+	}
+
+    /**
+     * Inserts the specified element to the beginning of this list.
+     */
+    void addFirst(T &e) {
+		linkBefore(front,e);
+	}
+
+    /**
+     * Insert the specified element to the end of this list.
+     * Equivalent to add.
+     */
+    void addLast(T &e) {
+		linkBefore(NULL,e);
+	}
+
+    /**
+     * Inserts e right before pos, which must be on this list.
+     * @throw ElementNotExist if pos is not on this list
+     */
+    void insertBefore(T &pos, T &e) {
+		if (hook(pos).list!=this) throw ElementNotExist("\nElement Not Exist\n");
+		linkBefore(&pos,e);
+	}
+
+    /**
+     * Inserts e right after pos, which must be on this list.
+     * @throw ElementNotExist if pos is not on this list
+     */
+    void insertAfter(T &pos, T &e) {
+		if (hook(pos).list!=this) throw ElementNotExist("\nElement Not Exist\n");
+		linkBefore(hook(pos).next,e);
+	}
+
+    /**
+     * Unlinks every element from this list.
+     */
+    void clear() {
+		while (front!=NULL) unlink(*front);
+	}
+
+    /**
+     * Returns true if the specified object is on this list, in O(1).
+     */
+    bool contains(const T &e) const {
+		return (e.*Hook).list==this;
+	}
+
+    /**
+     * Returns the first element.
+     * @throw ElementNotExist
+     */
+    T &getFirst() const {
+		if (front==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return *front;
+	}
+
+    /**
+     * Returns the last element.
+     * @throw ElementNotExist
+     */
+    T &getLast() const {
+		if (rear==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return *rear;
+	}
+
+    /**
+     * Returns the element following e on this list, or NULL if e is last.
+     * @throw ElementNotExist if e is not on this list
+     */
+    T *nextOf(const T &e) const {
+		if ((e.*Hook).list!=this) throw ElementNotExist("\nElement Not Exist\n");
+		return (e.*Hook).next;
+	}
+
+    /**
+     * Returns the element preceding e on this list, or NULL if e is first.
+     * @throw ElementNotExist if e is not on this list
+     */
+    T *prevOf(const T &e) const {
+		if ((e.*Hook).list!=this) throw ElementNotExist("\nElement Not Exist\n");
+		return (e.*Hook).pre;
+	}
+
+    /**
+     * Returns true if this list contains no elements.
+     */
+    bool isEmpty() const {
+		return front==NULL;
+	}
+
+    /**
+     * Unlinks the specified object from this list in O(1).
+     * Returns true if it was on this list, otherwise false.
+     */
+    bool remove(T &e) {
+		if (hook(e).list!=this) return false;
+		unlink(e);
+		return true;
+	}
+
+    /**
+     * Unlinks the first element from this list.
+     * @throw ElementNotExist
+     */
+    void removeFirst() {
+		if (front==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		unlink(*front);
+	}
+
+    /**
+     * Unlinks the last element from this list.
+     * @throw ElementNotExist
+     */
+    void removeLast() {
+		if (rear==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		unlink(*rear);
+	}
+
+    /**
+     * Returns the number of elements in this list.
+     */
+    int size() const {
+		return Size;
+	}
+
+    /**
+     * Returns an iterator over the elements in this list.
+     */
+    Iterator iterator() {
+		return Iterator(this);
+	}
+};
+
+#endif
@@ -21,6 +21,138 @@ class LinkedList
 		node(T data, node *pre=NULL, node *next=NULL) : data(data), pre(pre), next(next) {}
 	} *front, *rear;
 	int Size;
+	// the node reached by the last indexed access, and its index; NULL when
+	// unknown. Only non-const members move it, so concurrent const reads of
+	// the list stay safe.
+	node *finger;
+	int fingerIdx;
+
+	/**
+	 * Returns the node at index, walking from whichever of front, rear and
+	 * the finger is nearest.
+	 */
+	node *walk(int index) const {
+		node *tmp;
+		int dist=index, from=0;
+		tmp=front;
+		if (Size-1-index<dist) {
+			dist=Size-1-index;
+			tmp=rear;
+			from=Size-1;
+		}
+		if (finger!=NULL&&(fingerIdx>index?fingerIdx-index:index-fingerIdx)<dist) {
+			tmp=finger;
+			from=fingerIdx;
+		}
+		for (; from<index; ++from) tmp=tmp->next;
+		for (; from>index; --from) tmp=tmp->pre;
+		return tmp;
+	}
+
+	void dropFinger() {
+		finger=NULL;
+		fingerIdx=0;
+	}
+
+	/**
+	 * Returns the node at index like walk(), and leaves the finger on it.
+	 */
+	node *locate(int index) {
+		finger=walk(index);
+		fingerIdx=index;
+		return finger;
+	}
+
+	/**
+	 * Inserts a node holding e before pos (at the end if pos is NULL).
+	 */
+	node *linkBefore(node *pos, const T &e) {
+		node *cur;
+		if (pos==NULL) {
+			cur=new node(e,rear,NULL);
+			if (rear!=NULL) {
+				rear->next=cur;
+			} else {
+				front=cur;
+			}
+			rear=cur;
+		} else {
+			cur=new node(e,pos->pre,pos);
+			if (pos->pre!=NULL) {
+				pos->pre->next=cur;
+			} else {
+				front=cur;
+			}
+			pos->pre=cur;
+		}
+		++Size;
+		return cur;
+	}
+
+	/**
+	 * Unlinks and deletes cur, returning its successor.
+	 */
+	node *unlink(node *cur) {
+		node *nxt=cur->next;
+		if (cur->pre!=NULL) {
+			cur->pre->next=cur->next;
+		} else {
+			front=cur->next;
+		}
+		if (cur->next!=NULL) {
+			cur->next->pre=cur->pre;
+		} else {
+			rear=cur->pre;
+		}
+		delete cur;
+		--Size;
+		return nxt;
+	}
+
+	/**
+	 * Detaches the n nodes first..last (inclusive) without deleting them.
+	 */
+	void detach(node *first, node *last, int n) {
+		if (first->pre!=NULL) {
+			first->pre->next=last->next;
+		} else {
+			front=last->next;
+		}
+		if (last->next!=NULL) {
+			last->next->pre=first->pre;
+		} else {
+			rear=first->pre;
+		}
+		first->pre=last->next=NULL;
+		Size-=n;
+		dropFinger();
+	}
+
+	/**
+	 * Links the detached chain first..last of n nodes before pos (at the end
+	 * if pos is NULL).
+	 */
+	void attach(node *pos, node *first, node *last, int n) {
+		node *pre=(pos==NULL?rear:pos->pre);
+		first->pre=pre;
+		last->next=pos;
+		if (pre!=NULL) {
+			pre->next=first;
+		} else {
+			front=first;
+		}
+		if (pos!=NULL) {
+			pos->pre=last;
+		} else {
+			rear=last;
+		}
+		Size+=n;
+		dropFinger();
+	}
+
+	struct NaturalLess {
+		bool operator()(const T &a, const T &b) const { return a<b; }
+	};
 
 public:
     class Iterator
@@ -85,6 +217,95 @@ public:
 			delete last;
 			last=NULL;
 			--a->Size;
+			a->dropFinger();
+		}
+    };
+
+    /**
+     * A cursor stands on one element of the list, or past the last one, and
+     * can move in both directions and insert or remove at its position in
+     * O(1).
+     */
+    class Cursor
+    {
+		friend class LinkedList;
+		LinkedList *a;
+		node *cur;
+    public:
+		Cursor(LinkedList<T> *x, node *cur) : a(x), cur(cur) {}
+
+        /**
+         * Returns true if the cursor stands on an element, false if it is
+         * past the end.
+         */
+        bool hasElement() const {
+			return cur!=NULL;
+		}
+
+        /**
+         * Returns a const reference to the element under the cursor.
+         * @throw ElementNotExist
+         */
+        const T &get() const {
+			if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			return cur->data;
+		}
+
+        /**
+         * Replaces the element under the cursor.
+         * @throw ElementNotExist
+         */
+        void set(const T &e) {
+			if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			cur->data=e;
+		}
+
+        /**
+         * Moves to the following element, or past the end.
+         * @throw ElementNotExist if the cursor is past the end
+         */
+        void next() {
+			if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			cur=cur->next;
+		}
+
+        /**
+         * Moves to the preceding element.
+         * @throw ElementNotExist if the cursor is on the first element
+         */
+        void prev() {
+			node *tmp=(cur==NULL?a->rear:cur->pre);
+			if (tmp==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			cur=tmp;
+		}
+
+        /**
+         * Inserts e before the cursor (appends it if the cursor is past the
+         * end). The cursor stays on the same element.
+         */
+        void insertBefore(const T &e) {
+			a->linkBefore(cur,e);
+			a->dropFinger();
+		}
+
+        /**
+         * Inserts e after the element under the cursor.
+         * @throw ElementNotExist if the cursor is past the end
+         */
+        void insertAfter(const T &e) {
+			if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			a->linkBefore(cur->next,e);
+			a->dropFinger();
+		}
+
+        /**
+         * Removes the element under the cursor and moves to its successor.
+         * @throw ElementNotExist if the cursor is past the end
+         */
+        void remove() {
+			if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			cur=a->unlink(cur);
+			a->dropFinger();
 		}
     };
 
@@ -94,6 +315,7 @@ public:
     LinkedList () {
 		front=rear=NULL;
 		Size=0;
+		dropFinger();
 	}
 
     /**
@@ -113,6 +335,7 @@ public:
 			tmp=rear;
 		}
 		Size=c.Size;
+		dropFinger();
 	}
 
     /**
@@ -139,6 +362,7 @@ public:
 				tmp=rear;
 			}
 			Size=c.Size;
+			dropFinger();
 		}
 		return *this;
 	}
@@ -181,6 +405,7 @@ public:
 			front=front->pre;
 		}
 		++Size;
+		if (finger!=NULL) ++fingerIdx;
 	}
 
     /**
@@ -214,10 +439,7 @@ public:
 		} else if (index==Size) {
 			addLast(element);
 		} else {
-			node *tmp=front;
-			for (int i=1; i<index; ++i) {
-				tmp=tmp->next;
-			}
+			node *tmp=locate(index-1);
 			node *cur=new node(element,tmp,tmp->next);
 			tmp->next->pre=cur;
 			tmp->next=cur;
@@ -237,6 +459,7 @@ public:
 		}
 		Size=0;
 		front=rear=NULL;
+		dropFinger();
 	}
 
     /**
@@ -256,9 +479,17 @@ public:
      */
     const T& get(int index) const {
 		if (index<0||index>=Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
-		node *tmp=front;
-		for (int i=0; i<index; ++i) tmp=tmp->next;
-		return tmp->data;
+		return walk(index)->data;
+	}
+
+    /**
+     * Same as the const get(), but also leaves the finger on the element, so
+     * that a following access near index is cheap.
+     * @throw IndexOutOfBound
+     */
+    const T& get(int index) {
+		if (index<0||index>=Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		return locate(index)->data;
 	}
 
     /**
@@ -297,8 +528,13 @@ public:
      */
     void removeIndex(int index) {
 		if (index<0||index>=Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
-		node *tmp=front;
-		for (int i=0; i<index; ++i) tmp=tmp->next;
+		node *tmp=locate(index);
+		if (tmp->next!=NULL) {
+			finger=tmp->next;
+		} else {
+			finger=tmp->pre;
+			fingerIdx=(finger==NULL?0:fingerIdx-1);
+		}
 		if (tmp->pre!=NULL) {
 			tmp->pre->next=tmp->next;
 		} else {
@@ -318,8 +554,14 @@ public:
      * Returns true if it was present in the list, otherwise false.
      */
     bool remove(const T &e) {
-		for (node *tmp=front; tmp!=NULL; tmp=tmp->next) {
+		int i=0;
+		for (node *tmp=front; tmp!=NULL; tmp=tmp->next, ++i) {
 			if (tmp->data==e) {
+				if (tmp==finger) {
+					dropFinger();
+				} else if (finger!=NULL&&i<fingerIdx) {
+					--fingerIdx;
+				}
 				if (tmp->pre!=NULL) {
 					tmp->pre->next=tmp->next;
 				} else {
@@ -345,6 +587,11 @@ public:
     void removeFirst() {
 		if (front==NULL) throw ElementNotExist("\nElement Not Exist\n");
 		node *tmp=front;
+		if (finger==front) {
+			dropFinger();
+		} else if (finger!=NULL) {
+			--fingerIdx;
+		}
 		front=front->next;
 		if (front!=NULL) {
 			front->pre=NULL;
@@ -362,6 +609,7 @@ public:
     void removeLast() {
 		if (rear==NULL) throw ElementNotExist("\nElement Not Exist\n");
 		node *tmp=rear;
+		if (finger==rear) dropFinger();
 		rear=rear->pre;
 		if (rear!=NULL) {
 			rear->next=NULL;
@@ -379,9 +627,7 @@ public:
      */
     void set(int index, const T &element) {
 		if (index<0||index>=Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
-		node *tmp=front;
-		for (int i=0; i<index; ++i) tmp=tmp->next;
-		tmp->data=element;
+		locate(index)->data=element;
 	}
 
     /**
@@ -391,12 +637,200 @@ public:
 		return Size;
 	}
 
+    /**
+     * Moves all elements of other into this list before the specified
+     * position, leaving other empty. Nodes are relinked, not copied.
+     * The range of pos is [0, size].
+     * @throw IndexOutOfBound
+     */
+    void splice(int pos, LinkedList &other) {
+		splice(pos,other,0,other.Size);
+	}
+
+    /**
+     * Moves the elements of other with indices in [first, last) into this
+     * list before the specified position. Nodes are relinked, not copied,
+     * but finding them by index costs O(n); the Cursor overloads avoid it.
+     * If other is this list, pos must not lie strictly inside the range.
+     * @throw IndexOutOfBound
+     */
+    void splice(int pos, LinkedList &other, int first, int last) {
+		if (pos<0||pos>Size||first<0||last>other.Size||first>last) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		if (first==last) return;
+		if (&other==this) {
+			if (pos>first&&pos<last) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+			if (pos==first||pos==last) return;
+		}
+		node *a=other.locate(first), *b=other.locate(last-1);
+		node *at=(pos==Size?NULL:locate(pos));
+		other.detach(a,b,last-first);
+		attach(at,a,b,last-first);
+	}
+
+    /**
+     * Moves all elements of other into this list before the cursor pos, in
+     * O(1), leaving other empty. Cursors on the moved elements must not be
+     * used afterwards.
+     * @throw IndexOutOfBound if pos is not a cursor of this list or other is
+     * this list
+     */
+    void splice(const Cursor &pos, LinkedList &other) {
+		if (pos.a!=this||&other==this) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		if (other.front==NULL) return;
+		int n=other.Size;
+		node *a=other.front, *b=other.rear;
+		other.detach(a,b,n);
+		attach(pos.cur,a,b,n);
+	}
+
+    /**
+     * Moves the element under the cursor it, from other, into this list
+     * before the cursor pos, in O(1). other may be this list.
+     * @throw IndexOutOfBound if pos is not a cursor of this list or it is
+     * not a cursor of other
+     * @throw ElementNotExist if it is past the end
+     */
+    void splice(const Cursor &pos, LinkedList &other, const Cursor &it) {
+		if (pos.a!=this||it.a!=&other) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		if (it.cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		if (&other==this&&(it.cur==pos.cur||it.cur->next==pos.cur)) return;
+		other.detach(it.cur,it.cur,1);
+		attach(pos.cur,it.cur,it.cur,1);
+	}
+
+    /**
+     * Moves the elements of other from the cursor first up to, but not
+     * including, the cursor last into this list before the cursor pos.
+     * This is O(1) when other is this list, in which case first must not
+     * come after last and pos must not lie strictly inside the range;
+     * otherwise the moved elements are counted, in O(last - first).
+     * @throw IndexOutOfBound if pos is not a cursor of this list, if first
+     * and last are not cursors of other, if first is past the end while
+     * last is not, or if other is not this list and last comes before first
+     */
+    void splice(const Cursor &pos, LinkedList &other, const Cursor &first, const Cursor &last) {
+		if (pos.a!=this||first.a!=&other||last.a!=&other) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		if (first.cur==last.cur) return;
+		if (first.cur==NULL) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		if (&other==this&&(pos.cur==first.cur||pos.cur==last.cur)) return;
+		node *a=first.cur, *b=(last.cur==NULL?other.rear:last.cur->pre);
+		int n=0;
+		if (&other!=this) {
+			for (node *tmp=a; tmp!=last.cur; tmp=tmp->next) {
+				if (tmp==NULL) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+				++n;
+			}
+		}
+		other.detach(a,b,n);
+		attach(pos.cur,a,b,n);
+	}
+
+    /**
+     * Moves all elements of other to the end of this list in O(1), leaving
+     * other empty.
+     */
+    void concat(LinkedList &other) {
+		if (&other==this||other.front==NULL) return;
+		int n=other.Size;
+		node *a=other.front, *b=other.rear;
+		other.detach(a,b,n);
+		attach(NULL,a,b,n);
+	}
+
+    /**
+     * Moves the elements with indices in [index, size) into rest, which is
+     * cleared first. This list keeps the elements in [0, index).
+     * @throw IndexOutOfBound
+     */
+    void splitAt(int index, LinkedList &rest) {
+		if (index<0||index>Size||&rest==this) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		rest.clear();
+		if (index==Size) return;
+		int n=Size-index;
+		node *a=locate(index), *b=rear;
+		detach(a,b,n);
+		rest.attach(NULL,a,b,n);
+	}
+
+    /**
+     * Sorts this list into ascending order with respect to cmp, which is
+     * used like the Comparator of PriorityQueue. The sort is a stable
+     * bottom-up merge sort on the links: it allocates nothing and never
+     * copies an element.
+     */
+    template <class C>
+    void sort(C cmp) {
+		if (Size<2) return;
+		node *list=front, *tail=NULL;
+		for (int k=1; ; k*=2) {
+			node *p=list;
+			list=tail=NULL;
+			int merges=0;
+			while (p!=NULL) {
+				++merges;
+				node *q=p;
+				int psize=0, qsize=k;
+				while (psize<k&&q!=NULL) {
+					++psize;
+					q=q->next;
+				}
+				while (psize>0||(qsize>0&&q!=NULL)) {
+					node *e;
+					if (psize>0&&(qsize==0||q==NULL||!cmp(q->data,p->data))) {
+						e=p;
+						p=p->next;
+						--psize;
+					} else {
+						e=q;
+						q=q->next;
+						--qsize;
+					}
+					if (tail!=NULL) {
+						tail->next=e;
+					} else {
+						list=e;
+					}
+					tail=e;
+				}
+				p=q;
+			}
+			tail->next=NULL;
+			if (merges<=1) break;
+		}
+		front=list;
+		rear=tail;
+		node *pre=NULL;
+		for (node *tmp=front; tmp!=NULL; tmp=tmp->next) {
+			tmp->pre=pre;
+			pre=tmp;
+		}
+		dropFinger();
+	}
+
+    /**
+     * Sorts this list into ascending order with respect to operator<.
+     */
+    void sort() {
+		sort(NaturalLess());
+	}
+
     /**
      * TODO Returns an iterator over the elements in this list.
      */
     Iterator iterator() {
 		return Iterator(this);
 	}
+
+    /**
+     * Returns a cursor standing on the element at the specified position.
+     * The range of index parameter is [0, size], where index=size gives a
+     * cursor past the last element.
+     * @throw IndexOutOfBound
+     */
+    Cursor cursor(int index) {
+		if (index<0||index>Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		return Cursor(this,index==Size?NULL:locate(index));
+	}
 };
 
 #endif
@@ -0,0 +1,408 @@
+/** @file */
+#ifndef __LRUCACHE_H
+#define __LRUCACHE_H
+
+#include "ElementNotExist.h"
+#include <cstddef>
+
+/**
+ * Default weigher for LruCache: every entry weighs sizeof(K)+sizeof(V) bytes.
+ * A weigher should be a class with a static function named ``weight'' which
+ * takes a key and a value and returns a long long.
+ */
+template <class K, class V>
+class DefaultWeight
+{
+public:
+    static long long weight(const K &, const V &) { return sizeof(K)+sizeof(V); }
+};
+
+/**
+ * LruCache is a bounded map that evicts the least recently used entry when it
+ * is full. The bound is a number of entries, a total weight in bytes as given
+ * by W, or both (a bound <= 0 means unbounded).
+ *
+ * H is the hash function, with the same requirements as in HashMap.
+ *
+ * Every entry lives in one node that carries both its hash chain link and its
+ * recency links, so get, put and eviction are O(1) and a hit allocates nothing.
+ * When the cache is full, put reuses the node of the evicted entry.
+ *
+ * With a protected capacity > 0 the cache works as a segmented LRU (a 2Q
+ * variant): new entries enter a probation segment, an entry hit while on
+ * probation is promoted to the protected segment, and when the protected
+ * segment overflows its least recently used entry is demoted back to
+ * probation. Victims are taken from probation first, so a burst of one-hit
+ * keys cannot flush the entries that are used repeatedly.
+ */
+template <class K, class V, class H, class W = DefaultWeight<K,V> >
+class LruCache
+{
+	struct node {
+		K key;
+		V value;
+		long long weight;
+		node *hnext;
+		node *pre, *next;
+		int seg;
+		node(const K &key, const V &value) : key(key), value(value) {}
+	};
+	const static int Omod=97;
+
+	node **elem;
+	int Mod, Size;
+	// segment 0 is probation (the only one for a plain LRU), 1 is protected;
+	// front is the most recently used end
+	node *front[2], *rear[2];
+	int count[2];
+	int maxCount, maxProtected;
+	long long maxBytes, bytes;
+	long long hitCount, missCount, evictCount;
+	void (*listener)(const K &, const V &, void *);
+	void *listenerArg;
+
+	int hash(const K &key) const {
+		return (H::hashCode(key)%Mod+Mod)%Mod;
+	}
+
+	void init(int maxC, long long maxB, int maxP) {
+		maxCount=maxC;
+		maxBytes=maxB;
+		maxProtected=maxP;
+		Mod=Omod;
+		while (maxCount>0&&Mod*4<maxCount*5) Mod*=2;
+		elem=new node *[Mod];
+		for (int i=0; i<Mod; ++i) elem[i]=NULL;
+		Size=0;
+		bytes=0;
+		front[0]=front[1]=rear[0]=rear[1]=NULL;
+		count[0]=count[1]=0;
+		hitCount=missCount=evictCount=0;
+		listener=NULL;
+		listenerArg=NULL;
+	}
+
+	void rehash() {
+		node **e=elem;
+		int tmod=Mod;
+		Mod*=2;
+		elem=new node *[Mod];
+		for (int i=0; i<Mod; ++i) elem[i]=NULL;
+		for (int i=0; i<tmod; ++i) {
+			node *cur=e[i];
+			while (cur!=NULL) {
+				node *tmp=cur->hnext;
+				int index=hash(cur->key);
+				cur->hnext=elem[index];
+				elem[index]=cur;
+				cur=tmp;
+			}
+		}
+		delete []e;
+	}
+
+	node *find(const K &key) const {
+		for (node *tmp=elem[hash(key)]; tmp!=NULL; tmp=tmp->hnext) {
+			if (tmp->key==key) return tmp;
+		}
+		return NULL;
+	}
+
+	void unlinkHash(node *cur) {
+		node **link=&elem[hash(cur->key)];
+		while (*link!=cur) link=&(*link)->hnext;
+		*link=cur->hnext;
+	}
+
+	void unlinkList(node *cur) {
+		int s=cur->seg;
+		if (cur->pre!=NULL) {
+			cur->pre->next=cur->next;
+		} else {
+			front[s]=cur->next;
+		}
+		if (cur->next!=NULL) {
+			cur->next->pre=cur->pre;
+		} else {
+			rear[s]=cur->pre;
+		}
+		--count[s];
+	}
+
+	void pushFront(node *cur, int s) {
+		cur->seg=s;
+		cur->pre=NULL;
+		cur->next=front[s];
+		if (front[s]!=NULL) {
+			front[s]->pre=cur;
+		} else {
+			rear[s]=cur;
+		}
+		front[s]=cur;
+		++count[s];
+	}
+
+	void touch(node *cur) {
+		unlinkList(cur);
+		if (maxProtected<=0) {
+			pushFront(cur,0);
+			return;
+		}
+		pushFront(cur,1);
+		if (count[1]>maxProtected) {
+			node *tmp=rear[1];
+			unlinkList(tmp);
+			pushFront(tmp,0);
+		}
+	}
+
+	/**
+	 * Returns the entry to evict next, other than keep: the least recently
+	 * used one on probation, or else the least recently used protected one.
+	 * Returns NULL when keep is the only entry.
+	 */
+	node *victim(node *keep) const {
+		for (int s=0; s<2; ++s) {
+			node *cur=rear[s];
+			if (cur==keep) cur=cur->pre;
+			if (cur!=NULL) return cur;
+		}
+		return NULL;
+	}
+
+	/**
+	 * Detaches cur from the cache and reports it to the listener. The
+	 * caller either reuses or deletes the returned node.
+	 */
+	node *evict(node *cur) {
+		unlinkList(cur);
+		unlinkHash(cur);
+		--Size;
+		bytes-=cur->weight;
+		++evictCount;
+		if (listener!=NULL) listener(cur->key,cur->value,listenerArg);
+		return cur;
+	}
+
+	void trim(node *keep) {
+		while (maxBytes>0&&bytes>maxBytes) {
+			node *cur=victim(keep);
+			if (cur==NULL) break;
+			delete evict(cur);
+		}
+	}
+
+	void release() {
+		for (int s=0; s<2; ++s) {
+			node *cur=front[s];
+			while (cur!=NULL) {
+				node *tmp=cur->next;
+				delete cur;
+				cur=tmp;
+			}
+		}
+		delete []elem;
+	}
+
+	void copyFrom(const LruCache &x) {
+		init(x.maxCount,x.maxBytes,x.maxProtected);
+		listener=x.listener;
+		listenerArg=x.listenerArg;
+		hitCount=x.hitCount;
+		missCount=x.missCount;
+		evictCount=x.evictCount;
+		for (int s=0; s<2; ++s) {
+			for (node *tmp=x.rear[s]; tmp!=NULL; tmp=tmp->pre) {
+				node *cur=new node(tmp->key,tmp->value);
+				cur->weight=tmp->weight;
+				int index=hash(cur->key);
+				cur->hnext=elem[index];
+				elem[index]=cur;
+				pushFront(cur,s);
+				++Size;
+				bytes+=cur->weight;
+				if (Size*5>Mod*4) rehash();
+			}
+		}
+	}
+
+public:
+    /**
+     * Constructs an empty cache holding at most maxCount entries and at most
+     * maxBytes of total weight. A bound <= 0 is not enforced. A protectedCount
+     * > 0 turns on the segmented (2Q) policy with a protected segment of that
+     * many entries.
+     */
+    explicit LruCache(int maxCount, long long maxBytes=0, int protectedCount=0) {
+		init(maxCount,maxBytes,protectedCount);
+	}
+
+    /**
+     * Destructor
+     */
+    ~LruCache() {
+		release();
+	}
+
+    /**
+     * Assignment operator
+     */
+    LruCache &operator=(const LruCache &x) {
+		if (this!=&x) {
+			release();
+			copyFrom(x);
+		}
+		return *this;
+	}
+
+    /**
+     * Copy-constructor
+     */
+    LruCache(const LruCache &x) {
+		copyFrom(x);
+	}
+
+    /**
+     * Sets the function called with the key and value of every evicted
+     * entry, together with arg. Entries removed by remove() or clear() are
+     * not reported.
+     */
+    void setEvictionListener(void (*f)(const K &, const V &, void *), void *arg=NULL) {
+		listener=f;
+		listenerArg=arg;
+	}
+
+    /**
+     * Removes all of the entries from this cache. The statistics are kept.
+     */
+    void clear() {
+		int c=maxCount, p=maxProtected;
+		long long b=maxBytes, h=hitCount, m=missCount, e=evictCount;
+		void (*f)(const K &, const V &, void *)=listener;
+		void *arg=listenerArg;
+		release();
+		init(c,b,p);
+		hitCount=h;
+		missCount=m;
+		evictCount=e;
+		listener=f;
+		listenerArg=arg;
+	}
+
+    /**
+     * Returns true if this cache contains an entry for the specified key.
+     * Neither the recency order nor the statistics are changed.
+     */
+    bool containsKey(const K &key) const {
+		return find(key)!=NULL;
+	}
+
+    /**
+     * Returns a const reference to the value cached for the specified key and
+     * marks the entry as most recently used.
+     * If the key is not present, counts a miss and throws ElementNotExist.
+     * @throw ElementNotExist
+     */
+    const V &get(const K &key) {
+		node *cur=find(key);
+		if (cur==NULL) {
+			++missCount;
+			throw ElementNotExist("\nElement Not Exist\n");
+		}
+		++hitCount;
+		touch(cur);
+		return cur->value;
+	}
+
+    /**
+     * Associates the specified value with the specified key and marks the
+     * entry as most recently used, evicting entries to stay within bounds.
+     */
+    void put(const K &key, const V &value) {
+		node *cur=find(key);
+		if (cur!=NULL) {
+			bytes-=cur->weight;
+			cur->value=value;
+			cur->weight=W::weight(key,value);
+			bytes+=cur->weight;
+			touch(cur);
+			trim(cur);
+			return;
+		}
+		if (maxCount>0&&Size>=maxCount) {
+			cur=evict(victim(NULL));
+			cur->key=key;
+			cur->value=value;
+		} else {
+			cur=new node(key,value);
+		}
+		cur->weight=W::weight(key,value);
+		int index=hash(key);
+		cur->hnext=elem[index];
+		elem[index]=cur;
+		pushFront(cur,0);
+		++Size;
+		bytes+=cur->weight;
+		if (Size*5>Mod*4) rehash();
+		trim(cur);
+	}
+
+    /**
+     * Removes the entry for the specified key.
+     * If there is no entry for the key, throws ElementNotExist exception.
+     * @throw ElementNotExist
+     */
+    void remove(const K &key) {
+		node *cur=find(key);
+		if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		unlinkList(cur);
+		unlinkHash(cur);
+		--Size;
+		bytes-=cur->weight;
+		delete cur;
+	}
+
+    /**
+     * Returns true if this cache contains no entries.
+     */
+    bool isEmpty() const {
+		return Size==0;
+	}
+
+    /**
+     * Returns the number of entries in this cache.
+     */
+    int size() const {
+		return Size;
+	}
+
+    /**
+     * Returns the total weight of the entries in this cache.
+     */
+    long long weight() const {
+		return bytes;
+	}
+
+    /**
+     * Returns the number of get() calls that found their key.
+     */
+    long long hits() const {
+		return hitCount;
+	}
+
+    /**
+     * Returns the number of get() calls that did not find their key.
+     */
+    long long misses() const {
+		return missCount;
+	}
+
+    /**
+     * Returns the number of entries evicted to stay within bounds.
+     */
+    long long evictions() const {
+		return evictCount;
+	}
+};
+
+#endif
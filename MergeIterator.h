@@ -0,0 +1,190 @@
+/** @file */
+#ifndef __MERGEITERATOR_H
+#define __MERGEITERATOR_H
+
+#include "PriorityQueue.h"
+#include "ArrayList.h"
+#include "ElementNotExist.h"
+
+/**
+ * Merges several sorted sources into one sorted sequence using a loser tree
+ * (tournament tree). Each output element costs one pass from a leaf to the
+ * root, i.e. about log2(k) comparisons for k sources.
+ *
+ * S is the iterator type of the sources, for instance ArrayList<T>::Iterator,
+ * LinkedList<T>::Iterator or Deque<T>::Iterator. Every source must already be
+ * sorted with respect to C (used as in PriorityQueue), and the containers
+ * must not change while they are being merged. The merge is stable: equal
+ * elements come out in the order their sources were added.
+ *
+ * The current element of each source is copied as soon as it is read, so
+ * sources whose next() returns storage of their own that the following call
+ * overwrites (BTreeMap<K,V>::Iterator, for instance) are merged correctly.
+ * T must be default-constructible.
+ */
+template <class T, class S, class C = Less<T> >
+class MergeIterator
+{
+	ArrayList<S *> src;
+	// source i owns the buffers head[2i] and head[2i+1]; head[2i+side[i]]
+	// is a copy of its current element, valid while done[i] is false. The
+	// other buffer still holds the element next() returned before, so that
+	// reference survives until the following call without a further copy
+	ArrayList<T> head;
+	ArrayList<int> side;
+	ArrayList<bool> done;
+	// tree.elem[0] is the winner; tree.elem[1..k-1] hold the losers
+	ArrayList<int> tree;
+	// number of sources not yet exhausted
+	int alive;
+	bool built;
+	C cmp;
+
+	/**
+	 * Returns true if source a must come out before source b.
+	 */
+	bool beats(int a, int b) {
+		if (done.elem[a]) return false;
+		if (done.elem[b]) return true;
+		if (cmp(current(a),current(b))) return true;
+		if (cmp(current(b),current(a))) return false;
+		return a<b;
+	}
+
+	void build() {
+		int k=src.Size;
+		built=true;
+		if (k==0) return;
+		ArrayList<int> win;
+		for (int i=0; i<2*k; ++i) {
+			win.add(i<k?0:i-k);
+			tree.add(0);
+		}
+		for (int n=k-1; n>=1; --n) {
+			int l=win.elem[2*n], r=win.elem[2*n+1];
+			if (beats(l,r)) {
+				win.elem[n]=l;
+				tree.elem[n]=r;
+			} else {
+				win.elem[n]=r;
+				tree.elem[n]=l;
+			}
+		}
+		tree.elem[0]=(k==1?0:win.elem[1]);
+	}
+
+	T &current(int i) {
+		return head.elem[2*i+side.elem[i]];
+	}
+
+	/**
+	 * Reads the next element of source w into its other buffer, or marks w
+	 * done.
+	 */
+	void advance(int w) {
+		if (src.elem[w]->hasNext()) {
+			side.elem[w]^=1;
+			current(w)=src.elem[w]->next();
+		} else {
+			done.elem[w]=true;
+			--alive;
+		}
+	}
+
+	/**
+	 * Advances the winning source and replays its path to the root.
+	 */
+	void step() {
+		int k=src.Size, w=tree.elem[0];
+		advance(w);
+		for (int n=(w+k)>>1; n>=1; n>>=1) {
+			if (beats(tree.elem[n],w)) {
+				int tmp=tree.elem[n];
+				tree.elem[n]=w;
+				w=tmp;
+			}
+		}
+		tree.elem[0]=w;
+	}
+
+	MergeIterator(const MergeIterator &);
+	MergeIterator &operator=(const MergeIterator &);
+
+public:
+    /**
+     * Constructs a merge over no sources.
+     */
+    MergeIterator() : alive(0), built(false) {}
+
+    /**
+     * Destructor
+     */
+    ~MergeIterator() {
+		for (int i=0; i<src.Size; ++i) delete src.elem[i];
+	}
+
+    /**
+     * Adds a sorted source. Sources must all be added before the first call
+     * to hasNext(), next() or mergeInto().
+     * @throw ElementNotExist if the merge has already started
+     */
+    void add(const S &it) {
+		if (built) throw ElementNotExist("\nElement Not Exist\n");
+		src.add(new S(it));
+		head.add(T());
+		head.add(T());
+		side.add(0);
+		done.add(false);
+		++alive;
+		advance(src.Size-1);
+	}
+
+    /**
+     * Returns true if the iteration has more elements.
+     */
+    bool hasNext() {
+		if (!built) build();
+		return src.Size>0&&!done.elem[tree.elem[0]];
+	}
+
+    /**
+     * Returns the least remaining element over all sources. The reference
+     * is valid until the next call.
+     * @throw ElementNotExist exception when hasNext() == false
+     */
+    const T &next() {
+		if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
+		const T &x=current(tree.elem[0]);
+		step();
+		return x;
+	}
+
+    /**
+     * Appends all remaining elements to out, in order, and returns how many
+     * were appended. With a single source left it copies that source
+     * directly without going through the tree.
+     */
+    int mergeInto(ArrayList<T> &out) {
+		int n=0;
+		while (hasNext()) {
+			if (alive==1) {
+				int w=tree.elem[0];
+				out.add(current(w));
+				++n;
+				while (src.elem[w]->hasNext()) {
+					out.add(src.elem[w]->next());
+					++n;
+				}
+				done.elem[w]=true;
+				alive=0;
+				break;
+			}
+			out.add(current(tree.elem[0]));
+			++n;
+			step();
+		}
+		return n;
+	}
+};
+
+#endif
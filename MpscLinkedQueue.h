@@ -0,0 +1,199 @@
+/** @file */
+#ifndef __MPSCLINKEDQUEUE_H
+#define __MPSCLINKEDQUEUE_H
+
+#include "ElementNotExist.h"
+#include "LinkedList.h"
+#include <atomic>
+#include <cstddef>
+
+/**
+ * A multi-producer / single-consumer FIFO queue (Vyukov's intrusive MPSC
+ * queue). Requires C++11.
+ *
+ * Any number of threads may call push() concurrently; linking a node is a
+ * single atomic exchange plus a store. Only one thread at a time may call
+ * pop(), front(), isEmpty() or drainAll(); popping needs no read-modify-write
+ * atomics. Like LinkedList the queue is a chain of nodes, but the chain runs
+ * from the consumer end (tail, a consumed dummy node) to the producer end
+ * (head).
+ *
+ * A push that has exchanged head but not yet linked its node is not visible
+ * to the consumer, so pop() may briefly report an empty queue while a
+ * producer is in the middle of a push.
+ *
+ * Consumed nodes are recycled through a per-queue free list. The consumer
+ * returns them in batches, and producers take them under a try-lock,
+ * falling back to new when the free list is empty or busy.
+ */
+template <class T>
+class MpscLinkedQueue
+{
+	struct node {
+		std::atomic<node *> next;
+		T data;
+		node() : next(NULL) {}
+		node(const T &data) : next(NULL), data(data) {}
+	};
+	const static int BATCH=64;
+	const static int MAXFREE=4096;
+
+	alignas(64) std::atomic<node *> head;
+	alignas(64) node *tail;
+	// consumed nodes not yet handed back to the free list (consumer only)
+	node *spare;
+	int spareCount;
+	alignas(64) std::atomic_flag freeLock;
+	node *freeList;
+	int freeCount;
+
+	node *alloc(const T &value) {
+		node *cur=NULL;
+		if (!freeLock.test_and_set(std::memory_order_acquire)) {
+			cur=freeList;
+			if (cur!=NULL) {
+				freeList=cur->next.load(std::memory_order_relaxed);
+				--freeCount;
+			}
+			freeLock.clear(std::memory_order_release);
+		}
+		if (cur==NULL) return new node(value);
+		cur->data=value;
+		cur->next.store(NULL,std::memory_order_relaxed);
+		return cur;
+	}
+
+	void recycle(node *cur) {
+		cur->next.store(spare,std::memory_order_relaxed);
+		spare=cur;
+		if (++spareCount<BATCH) return;
+		if (!freeLock.test_and_set(std::memory_order_acquire)) {
+			if (freeCount<MAXFREE) {
+				node *last=spare;
+				while (last->next.load(std::memory_order_relaxed)!=NULL) last=last->next.load(std::memory_order_relaxed);
+				last->next.store(freeList,std::memory_order_relaxed);
+				freeList=spare;
+				freeCount+=spareCount;
+				spare=NULL;
+				spareCount=0;
+			}
+			freeLock.clear(std::memory_order_release);
+		}
+		while (spareCount>BATCH) {
+			node *tmp=spare;
+			spare=tmp->next.load(std::memory_order_relaxed);
+			delete tmp;
+			--spareCount;
+		}
+	}
+
+	static void destroy(node *cur) {
+		while (cur!=NULL) {
+			node *tmp=cur->next.load(std::memory_order_relaxed);
+			delete cur;
+			cur=tmp;
+		}
+	}
+
+	MpscLinkedQueue(const MpscLinkedQueue &);
+	MpscLinkedQueue &operator=(const MpscLinkedQueue &);
+
+public:
+    /**
+     * Constructs an empty queue.
+     */
+    MpscLinkedQueue() : spare(NULL), spareCount(0), freeList(NULL), freeCount(0) {
+		freeLock.clear();
+		tail=new node();
+		head.store(tail);
+	}
+
+    /**
+     * Destructor. No other thread may be using the queue.
+     */
+    ~MpscLinkedQueue() {
+		destroy(tail);
+		destroy(spare);
+		destroy(freeList);
+	}
+
+    /**
+     * Appends the specified element. Safe to call from any thread.
+     */
+    void push(const T &value) {
+		node *cur=alloc(value);
+		node *prev=head.exchange(cur,std::memory_order_acq_rel);
+		prev->next.store(cur,std::memory_order_release);
+	}
+
+    /**
+     * Returns true if the consumer sees no element. Consumer only.
+     */
+    bool isEmpty() const {
+		return tail->next.load(std::memory_order_acquire)==NULL;
+	}
+
+    /**
+     * Returns a const reference to the oldest element. Consumer only.
+     * @throw ElementNotExist
+     */
+    const T &front() const {
+		node *nxt=tail->next.load(std::memory_order_acquire);
+		if (nxt==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return nxt->data;
+	}
+
+    /**
+     * Removes the oldest element and stores it in value. Returns false,
+     * leaving value unchanged, if the consumer sees no element.
+     * Consumer only.
+     */
+    bool pop(T &value) {
+		node *nxt=tail->next.load(std::memory_order_acquire);
+		if (nxt==NULL) return false;
+		value=nxt->data;
+		node *tmp=tail;
+		tail=nxt;
+		recycle(tmp);
+		return true;
+	}
+
+    /**
+     * Copies every element the consumer sees to the end of out, in FIFO
+     * order, removes them from the queue, and returns how many there were.
+     * Each element costs a LinkedList node; drainAll(f) avoids that.
+     * Consumer only.
+     */
+    int drainAll(LinkedList<T> &out) {
+		int n=0;
+		for (node *nxt=tail->next.load(std::memory_order_acquire); nxt!=NULL; nxt=tail->next.load(std::memory_order_acquire)) {
+			out.addLast(nxt->data);
+			node *tmp=tail;
+			tail=nxt;
+			recycle(tmp);
+			++n;
+		}
+		return n;
+	}
+
+    /**
+     * Calls f(T &) on every element the consumer sees, in FIFO order, in
+     * place and without allocating, removes them from the queue, and
+     * returns how many there were. f may move from its argument.
+     * Consumer only.
+     */
+    template <class F>
+    int drainAll(F f) {
+		int n=0;
+		for (node *nxt=tail->next.load(std::memory_order_acquire); nxt!=NULL; nxt=tail->next.load(std::memory_order_acquire)) {
+			f(nxt->data);
+			node *tmp=tail;
+			tail=nxt;
+			recycle(tmp);
+			++n;
+		}
+		return n;
+	}
+};
+
+#endif
@@ -0,0 +1,394 @@
+/** @file */
+#ifndef __PAIRINGHEAP_H
+#define __PAIRINGHEAP_H
+
+#include "PriorityQueue.h"
+#include "ElementNotExist.h"
+
+/**
+ * A pairing heap with the interface of PriorityQueue (same Comparator
+ * convention: the head is the least element). On top of it, it offers
+ * merge(other) in O(1), push in O(1), pop in amortized O(log n), and
+ * decreaseKey through the Handle returned by push, in O(1) amortized.
+ *
+ * Nodes are carved out of chunks owned by the heap and recycled through a
+ * free list, so push does not call new once the heap has warmed up. merge()
+ * takes over the other heap's chunks along with its nodes.
+ *
+ * The iterator walks the chunks, so it returns every element exactly once
+ * even when Iterator::remove() is used, at a cost proportional to the
+ * number of slots allocated rather than to size().
+ */
+template <class V, class C = Less<V> >
+class PairingHeap
+{
+	struct node {
+		V data;
+		// prev is the parent for a first child and the left sibling otherwise
+		node *child, *sibling, *prev;
+		bool live;
+	};
+	const static int CHUNK=64;
+	struct chunk {
+		node slot[CHUNK];
+		chunk *next;
+	};
+
+	node *root;
+	int Size;
+	C cmp;
+	chunk *chunks, *lastChunk;
+	node *freeList, *freeTail;
+
+	node *alloc(const V &value) {
+		if (freeList==NULL) {
+			chunk *tmp=new chunk;
+			tmp->next=chunks;
+			if (chunks==NULL) lastChunk=tmp;
+			chunks=tmp;
+			for (int i=0; i<CHUNK; ++i) release(&tmp->slot[i]);
+		}
+		node *cur=freeList;
+		freeList=cur->sibling;
+		if (freeList==NULL) freeTail=NULL;
+		cur->data=value;
+		cur->child=cur->sibling=cur->prev=NULL;
+		cur->live=true;
+		return cur;
+	}
+
+	void release(node *cur) {
+		cur->live=false;
+		cur->sibling=freeList;
+		if (freeList==NULL) freeTail=cur;
+		freeList=cur;
+	}
+
+	/**
+	 * Links two detached roots and returns the new root.
+	 */
+	node *link(node *a, node *b) {
+		if (cmp(b->data,a->data)) {
+			node *tmp=a;
+			a=b;
+			b=tmp;
+		}
+		b->sibling=a->child;
+		if (a->child!=NULL) a->child->prev=b;
+		b->prev=a;
+		a->child=b;
+		a->sibling=a->prev=NULL;
+		return a;
+	}
+
+	node *meld(node *a, node *b) {
+		if (a==NULL) return b;
+		if (b==NULL) return a;
+		return link(a,b);
+	}
+
+	/**
+	 * Detaches the subtree rooted at cur (not the root) from its parent.
+	 */
+	void cut(node *cur) {
+		if (cur->prev->child==cur) {
+			cur->prev->child=cur->sibling;
+		} else {
+			cur->prev->sibling=cur->sibling;
+		}
+		if (cur->sibling!=NULL) cur->sibling->prev=cur->prev;
+		cur->sibling=cur->prev=NULL;
+	}
+
+	/**
+	 * Combines a list of siblings into one tree with the standard two-pass
+	 * pairing, without recursion.
+	 */
+	node *combine(node *first) {
+		if (first==NULL) return NULL;
+		node *acc=NULL;
+		while (first!=NULL) {
+			node *a=first, *b=a->sibling;
+			first=(b!=NULL?b->sibling:NULL);
+			a->sibling=a->prev=NULL;
+			if (b!=NULL) {
+				b->sibling=b->prev=NULL;
+				a=link(a,b);
+			}
+			a->sibling=acc;
+			acc=a;
+		}
+		node *res=acc;
+		acc=acc->sibling;
+		res->sibling=NULL;
+		while (acc!=NULL) {
+			node *tmp=acc->sibling;
+			acc->sibling=NULL;
+			res=link(res,acc);
+			acc=tmp;
+		}
+		return res;
+	}
+
+	/**
+	 * Takes cur out of the tree, keeping the node itself.
+	 */
+	void detach(node *cur) {
+		node *sub=combine(cur->child);
+		cur->child=NULL;
+		if (cur==root) {
+			root=sub;
+		} else {
+			cut(cur);
+			root=meld(root,sub);
+		}
+	}
+
+	void removeNode(node *cur) {
+		detach(cur);
+		release(cur);
+		--Size;
+	}
+
+	void init() {
+		root=NULL;
+		Size=0;
+		chunks=lastChunk=NULL;
+		freeList=freeTail=NULL;
+	}
+
+	void destroy() {
+		while (chunks!=NULL) {
+			chunk *tmp=chunks->next;
+			delete chunks;
+			chunks=tmp;
+		}
+	}
+
+	void copyFrom(const PairingHeap &x) {
+		init();
+		for (chunk *c=x.chunks; c!=NULL; c=c->next) {
+			for (int i=0; i<CHUNK; ++i) {
+				if (c->slot[i].live) push(c->slot[i].data);
+			}
+		}
+	}
+
+public:
+    /**
+     * Identifies one element pushed into the heap. A handle is valid until
+     * its element is popped or removed; using it afterwards is undefined.
+     */
+    class Handle
+    {
+		friend class PairingHeap;
+		node *p;
+		Handle(node *p) : p(p) {}
+    public:
+		Handle() : p(NULL) {}
+    };
+
+    class Iterator
+    {
+		PairingHeap *a;
+		chunk *c;
+		int pos;
+		node *last;
+
+		void skip() {
+			while (c!=NULL) {
+				while (pos<CHUNK&&!c->slot[pos].live) ++pos;
+				if (pos<CHUNK) return;
+				c=c->next;
+				pos=0;
+			}
+		}
+
+    public:
+		Iterator(PairingHeap *x) : a(x), c(x->chunks), pos(0), last(NULL) {}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        bool hasNext() {
+			skip();
+			return c!=NULL;
+		}
+
+        /**
+         * Returns the next element in the iteration.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        const V &next() {
+			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
+			last=&c->slot[pos++];
+			return last->data;
+		}
+
+		/**
+		 * Removes from the underlying heap the last element returned by the
+		 * iterator.
+		 * @throw ElementNotExist
+		 */
+		void remove() {
+			if (last==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			a->removeNode(last);
+			last=NULL;
+		}
+    };
+
+    /**
+     * Constructs an empty heap.
+     */
+    PairingHeap() {
+		init();
+	}
+
+    /**
+     * Destructor
+     */
+    ~PairingHeap() {
+		destroy();
+	}
+
+    /**
+     * Assignment operator. Handles into x do not carry over.
+     */
+    PairingHeap &operator=(const PairingHeap &x) {
+		if (this!=&x) {
+			destroy();
+			copyFrom(x);
+		}
+		return *this;
+	}
+
+    /**
+     * Copy-constructor. Handles into x do not carry over.
+     */
+    PairingHeap(const PairingHeap &x) {
+		copyFrom(x);
+	}
+
+    /**
+     * Returns an iterator over the elements in this heap.
+     */
+    Iterator iterator() {
+		return Iterator(this);
+	}
+
+    /**
+     * Removes all of the elements from this heap.
+     */
+    void clear() {
+		destroy();
+		init();
+	}
+
+    /**
+     * Returns a const reference to the front of the heap.
+     * @throw ElementNotExist
+     */
+    const V &front() const {
+		if (root==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return root->data;
+	}
+
+    /**
+     * Returns true if this heap contains no elements.
+     */
+    bool empty() const {
+		return Size==0;
+	}
+
+    /**
+     * Adds an element to the heap in O(1) and returns its handle.
+     */
+    Handle push(const V &value) {
+		node *cur=alloc(value);
+		root=meld(root,cur);
+		++Size;
+		return Handle(cur);
+	}
+
+    /**
+     * Removes the front element of this heap.
+     * @throw ElementNotExist
+     */
+    void pop() {
+		if (root==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		removeNode(root);
+	}
+
+    /**
+     * Returns a const reference to the element identified by h.
+     */
+    const V &get(const Handle &h) const {
+		return h.p->data;
+	}
+
+    /**
+     * Replaces the element identified by h with a value that is not greater,
+     * in O(1) amortized. A greater value is accepted too and handled like
+     * update().
+     */
+    void decreaseKey(const Handle &h, const V &value) {
+		node *cur=h.p;
+		if (cmp(cur->data,value)) {
+			update(h,value);
+			return;
+		}
+		cur->data=value;
+		if (cur!=root) {
+			cut(cur);
+			root=link(root,cur);
+		}
+	}
+
+    /**
+     * Replaces the element identified by h with any value, in amortized
+     * O(log n). The handle stays valid.
+     */
+    void update(const Handle &h, const V &value) {
+		node *cur=h.p;
+		detach(cur);
+		cur->data=value;
+		root=meld(root,cur);
+	}
+
+    /**
+     * Removes the element identified by h, in amortized O(log n).
+     */
+    void remove(const Handle &h) {
+		removeNode(h.p);
+	}
+
+    /**
+     * Moves every element of other into this heap in O(1), leaving other
+     * empty. Handles into other stay valid and now refer to this heap.
+     */
+    void merge(PairingHeap &other) {
+		if (&other==this) return;
+		root=meld(root,other.root);
+		Size+=other.Size;
+		if (other.chunks!=NULL) {
+			other.lastChunk->next=chunks;
+			if (chunks==NULL) lastChunk=other.lastChunk;
+			chunks=other.chunks;
+		}
+		if (other.freeList!=NULL) {
+			other.freeTail->sibling=freeList;
+			if (freeList==NULL) freeTail=other.freeTail;
+			freeList=other.freeList;
+		}
+		other.init();
+	}
+
+    /**
+     * Returns the number of elements in this heap.
+     */
+    int size() const {
+		return Size;
+	}
+};
+
+#endif
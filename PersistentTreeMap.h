@@ -0,0 +1,470 @@
+/** @file */
+#ifndef __PERSISTENTTREEMAP_H
+#define __PERSISTENTTREEMAP_H
+
+#include "ElementNotExist.h"
+#include "ArrayList.h"
+#include <atomic>
+#include <cstddef>
+#include <ctime>
+
+/**
+ * A treap map whose versions share structure, so that taking a snapshot is
+ * O(1) and readers never block the writer. Requires C++11.
+ *
+ * Nodes carry an atomic reference count, one per parent or root pointing at
+ * them. A node referenced more than once belongs to some snapshot and is
+ * never modified: put() and remove() copy the shared nodes on their search
+ * path (path copying, expected O(log n) nodes) and modify the copies. A node
+ * is freed when its last reference goes away, whether that is the writer
+ * replacing it or the last snapshot holding it being destroyed.
+ *
+ * The map itself is used by one writer thread at a time. Snapshots are
+ * immutable and may be read, copied and destroyed on any thread, concurrently
+ * with the writer and with each other. Copying the map, and iterating it, are
+ * O(1) snapshots too.
+ */
+template <class K, class V>
+class PersistentTreeMap
+{
+public:
+    class Entry
+    {
+        K key;
+        V value;
+    public:
+        Entry(K k, V v)
+        {
+            key = k;
+            value = v;
+        }
+
+        K getKey() const
+        {
+            return key;
+        }
+
+        V getValue() const
+        {
+            return value;
+        }
+
+		V &GetValue() {
+			return value;
+		}
+    };
+
+private:
+	struct node {
+		node *son[2];
+		Entry data;
+		int tag;
+		std::atomic<int> ref;
+		node(const Entry &data, int tag) : data(data), tag(tag), ref(1) {
+			son[0]=son[1]=NULL;
+		}
+	};
+
+	node *root;
+	int Size;
+	// state of this map's own priority generator (splitmix64)
+	unsigned long long seed;
+
+	int priority() {
+		unsigned long long z=(seed+=0x9E3779B97F4A7C15ULL);
+		z=(z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+		z=(z^(z>>27))*0x94D049BB133111EBULL;
+		return (int)((z^(z>>31))>>33);
+	}
+
+	static void acquire(node *cur) {
+		if (cur!=NULL) cur->ref.fetch_add(1,std::memory_order_relaxed);
+	}
+
+	/**
+	 * Drops one reference to cur, freeing every node that no longer has one
+	 * with an explicit stack rather than recursion.
+	 */
+	static void release(node *cur) {
+		if (cur==NULL||cur->ref.fetch_sub(1,std::memory_order_acq_rel)!=1) return;
+		ArrayList<node *> stack;
+		stack.add(cur);
+		while (stack.Size>0) {
+			cur=stack.elem[stack.Size-1];
+			stack.removeIndex(stack.Size-1);
+			for (int k=0; k<2; ++k) {
+				node *x=cur->son[k];
+				if (x!=NULL&&x->ref.fetch_sub(1,std::memory_order_acq_rel)==1) stack.add(x);
+			}
+			delete cur;
+		}
+	}
+
+	/**
+	 * Takes over the reference to cur held by the caller and returns a node
+	 * with the same contents that only the caller references, copying cur
+	 * if it is shared.
+	 */
+	static node *own(node *cur) {
+		if (cur->ref.load(std::memory_order_acquire)==1) return cur;
+		node *tmp=new node(cur->data,cur->tag);
+		for (int k=0; k<2; ++k) {
+			tmp->son[k]=cur->son[k];
+			acquire(tmp->son[k]);
+		}
+		release(cur);
+		return tmp;
+	}
+
+	static node *find(node *cur, const K &key) {
+		while (cur!=NULL) {
+			if (key<cur->data.getKey()) {
+				cur=cur->son[0];
+			} else if (cur->data.getKey()<key) {
+				cur=cur->son[1];
+			} else {
+				return cur;
+			}
+		}
+		return NULL;
+	}
+
+	static bool findValue(node *root, const V &value) {
+		ArrayList<node *> stack;
+		if (root!=NULL) stack.add(root);
+		while (stack.Size>0) {
+			node *cur=stack.elem[stack.Size-1];
+			stack.removeIndex(stack.Size-1);
+			if (cur->data.getValue()==value) return true;
+			if (cur->son[0]!=NULL) stack.add(cur->son[0]);
+			if (cur->son[1]!=NULL) stack.add(cur->son[1]);
+		}
+		return false;
+	}
+
+	/**
+	 * Splits the tree cur into l (keys less than key) and r (the others),
+	 * copying the shared nodes along the way. cur must not contain key.
+	 */
+	static void split(node *cur, const K &key, node *&l, node *&r) {
+		node **lp=&l, **rp=&r;
+		while (cur!=NULL) {
+			cur=own(cur);
+			if (cur->data.getKey()<key) {
+				*lp=cur;
+				lp=&cur->son[1];
+			} else {
+				*rp=cur;
+				rp=&cur->son[0];
+			}
+			cur=cur->son[cur->data.getKey()<key];
+		}
+		*lp=*rp=NULL;
+	}
+
+	/**
+	 * Joins a and b, whose keys are all less than b's, copying the shared
+	 * nodes along their inner spines.
+	 */
+	static node *merge(node *a, node *b) {
+		node *res=NULL, **p=&res;
+		while (a!=NULL&&b!=NULL) {
+			if (a->tag>b->tag) {
+				a=own(a);
+				*p=a;
+				p=&a->son[1];
+				a=a->son[1];
+			} else {
+				b=own(b);
+				*p=b;
+				p=&b->son[0];
+				b=b->son[0];
+			}
+		}
+		*p=(a!=NULL?a:b);
+		return res;
+	}
+
+public:
+    class Iterator
+    {
+		// the version being iterated, pinned for the iterator's lifetime
+		node *root;
+		ArrayList<node *> stack;
+
+		void pushLeft(node *cur) {
+			for (; cur!=NULL; cur=cur->son[0]) stack.add(cur);
+		}
+
+    public:
+		Iterator(node *root) : root(root) {
+			acquire(root);
+			pushLeft(root);
+		}
+
+		Iterator(const Iterator &x) : root(x.root), stack(x.stack) {
+			acquire(root);
+		}
+
+		Iterator &operator=(const Iterator &x) {
+			acquire(x.root);
+			release(root);
+			root=x.root;
+			stack=x.stack;
+			return *this;
+		}
+
+		~Iterator() {
+			release(root);
+		}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        bool hasNext() {
+			return stack.Size>0;
+		}
+
+        /**
+         * Returns the next element in the iteration.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        const Entry &next() {
+			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
+			node *cur=stack.elem[stack.Size-1];
+			stack.removeIndex(stack.Size-1);
+			pushLeft(cur->son[1]);
+			return cur->data;
+		}
+    };
+
+    /**
+     * An immutable version of the map. Any thread may read it while the
+     * writer goes on updating the map.
+     */
+    class Snapshot
+    {
+		node *root;
+		int Size;
+    public:
+		Snapshot(node *root, int Size) : root(root), Size(Size) {
+			acquire(root);
+		}
+
+		Snapshot(const Snapshot &x) : root(x.root), Size(x.Size) {
+			acquire(root);
+		}
+
+		Snapshot &operator=(const Snapshot &x) {
+			acquire(x.root);
+			release(root);
+			root=x.root;
+			Size=x.Size;
+			return *this;
+		}
+
+		~Snapshot() {
+			release(root);
+		}
+
+        /**
+         * Returns an iterator over the elements of this version in key order.
+         */
+        Iterator iterator() const {
+			return Iterator(root);
+		}
+
+        /**
+         * Returns true if this version contains a mapping for the specified key.
+         */
+        bool containsKey(const K &key) const {
+			return find(root,key)!=NULL;
+		}
+
+        /**
+         * Returns true if this version maps one or more keys to the specified value.
+         */
+        bool containsValue(const V &value) const {
+			return findValue(root,value);
+		}
+
+        /**
+         * Returns a const reference to the value to which the specified key is
+         * mapped in this version.
+         * @throw ElementNotExist
+         */
+        const V &get(const K &key) const {
+			node *cur=find(root,key);
+			if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			return cur->data.GetValue();
+		}
+
+        /**
+         * Returns true if this version contains no key-value mappings.
+         */
+        bool isEmpty() const {
+			return Size==0;
+		}
+
+        /**
+         * Returns the number of key-value mappings in this version.
+         */
+        int size() const {
+			return Size;
+		}
+    };
+
+    /**
+     * Constructs an empty map.
+     */
+    PersistentTreeMap() : root(NULL), Size(0) {
+		seed=(unsigned long long)time(0)*0x9E3779B97F4A7C15ULL^(unsigned long long)(size_t)this;
+	}
+
+    /**
+     * Constructs an empty map whose priorities are drawn from the given seed.
+     */
+    explicit PersistentTreeMap(unsigned long long seed) : root(NULL), Size(0), seed(seed) {}
+
+    /**
+     * Destructor. Nodes still shared with snapshots stay alive with them.
+     */
+    ~PersistentTreeMap() {
+		release(root);
+	}
+
+    /**
+     * Assignment operator, in O(1): both maps share x's nodes until either
+     * writes.
+     */
+    PersistentTreeMap &operator=(const PersistentTreeMap &x) {
+		acquire(x.root);
+		release(root);
+		root=x.root;
+		Size=x.Size;
+		return *this;
+	}
+
+    /**
+     * Copy-constructor, in O(1).
+     */
+    PersistentTreeMap(const PersistentTreeMap &x) : root(x.root), Size(x.Size), seed(x.seed^(unsigned long long)(size_t)this) {
+		acquire(root);
+	}
+
+    /**
+     * Returns the current version of the map in O(1).
+     */
+    Snapshot snapshot() const {
+		return Snapshot(root,Size);
+	}
+
+    /**
+     * Returns an iterator over the current version of the map, in key order.
+     * Later writes to the map do not affect it.
+     */
+    Iterator iterator() const {
+		return Iterator(root);
+	}
+
+    /**
+     * Removes all of the mappings from this map.
+     */
+    void clear() {
+		release(root);
+		root=NULL;
+		Size=0;
+	}
+
+    /**
+     * Returns true if this map contains a mapping for the specified key.
+     */
+    bool containsKey(const K &key) const {
+		return find(root,key)!=NULL;
+	}
+
+    /**
+     * Returns true if this map maps one or more keys to the specified value.
+     */
+    bool containsValue(const V &value) const {
+		return findValue(root,value);
+	}
+
+    /**
+     * Returns a const reference to the value to which the specified key is
+     * mapped. The reference is valid until the next write to the map.
+     * @throw ElementNotExist
+     */
+    const V &get(const K &key) const {
+		node *cur=find(root,key);
+		if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return cur->data.GetValue();
+	}
+
+    /**
+     * Returns true if this map contains no key-value mappings.
+     */
+    bool isEmpty() const {
+		return Size==0;
+	}
+
+    /**
+     * Associates the specified value with the specified key in this map,
+     * copying the nodes on its path that are shared with snapshots.
+     */
+    void put(const K &key, const V &value) {
+		node **slot=&root;
+		if (find(root,key)!=NULL) {
+			for (;;) {
+				node *cur=*slot=own(*slot);
+				if (key<cur->data.getKey()) {
+					slot=&cur->son[0];
+				} else if (cur->data.getKey()<key) {
+					slot=&cur->son[1];
+				} else {
+					cur->data.GetValue()=value;
+					return;
+				}
+			}
+		}
+		node *x=new node(Entry(key,value),priority());
+		while (*slot!=NULL&&(*slot)->tag>x->tag) {
+			node *cur=*slot=own(*slot);
+			slot=&cur->son[cur->data.getKey()<key];
+		}
+		split(*slot,key,x->son[0],x->son[1]);
+		*slot=x;
+		++Size;
+	}
+
+    /**
+     * Removes the mapping for the specified key from this map if present.
+     * @throw ElementNotExist
+     */
+    void remove(const K &key) {
+		if (find(root,key)==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		node **slot=&root;
+		for (;;) {
+			node *cur=*slot=own(*slot);
+			if (key<cur->data.getKey()) {
+				slot=&cur->son[0];
+			} else if (cur->data.getKey()<key) {
+				slot=&cur->son[1];
+			} else {
+				*slot=merge(cur->son[0],cur->son[1]);
+				delete cur;
+				--Size;
+				return;
+			}
+		}
+	}
+
+    /**
+     * Returns the number of key-value mappings in this map.
+     */
+    int size() const {
+		return Size;
+	}
+};
+
+#endif
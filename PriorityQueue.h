@@ -62,57 +62,175 @@ public:
 // }
 
 /*----------------------------------------------------------------------*/
-template <class V, class C = Less<V> >
-class PriorityQueue
+/**
+* The d-ary heap operations shared by PriorityQueue and IndexedPriorityQueue,
+* on the elements of data ordered by cmp. Every element moved from index f
+* to index t is reported as track.moved(f, t); the element being sifted is
+* reported as moved(i, -1) when it is lifted out and moved(-1, final) when
+* it is put back. NoTrack ignores the moves, and the compiler drops them.
+*/
+template <class V, class C, int D>
+struct DaryHeap
 {
-	ArrayList<V> data;
-	ArrayList<bool> tag;
-	int Size;
-	C cmp;
+	struct NoTrack {
+		void moved(int, int) {}
+	};
 
-	void swap1(V &a, V &b) {
-		V c=a;
-		a=b;
-		b=c;
+	/**
+	 * Moves the element at i up until its parent is not greater, and
+	 * returns its final index.
+	 */
+	template <class T>
+	static int siftUp(ArrayList<V> &data, C &cmp, int i, T &track) {
+		V x=data.elem[i];
+		track.moved(i,-1);
+		while (i) {
+			int p=(i-1)/D;
+			if (!cmp(x,data.elem[p])) break;
+			data.elem[i]=data.elem[p];
+			track.moved(p,i);
+			i=p;
+		}
+		data.elem[i]=x;
+		track.moved(-1,i);
+		return i;
 	}
 
-	void swap2(bool &a, bool &b) {
-		bool c=a;
-		a=b;
-		b=c;
+	/**
+	 * Moves the element at i down until no child is smaller, and returns
+	 * its final index.
+	 */
+	template <class T>
+	static int siftDown(ArrayList<V> &data, C &cmp, int i, T &track) {
+		V x=data.elem[i];
+		track.moved(i,-1);
+		int n=data.Size;
+		while (i*D+1<n) {
+			int c=i*D+1, end=(c+D<n?c+D:n);
+			// select with ?: rather than branch so it can compile to cmov
+			for (int j=c+1; j<end; ++j) c=cmp(data.elem[j],data.elem[c])?j:c;
+			if (!cmp(data.elem[c],x)) break;
+			data.elem[i]=data.elem[c];
+			track.moved(c,i);
+			i=c;
+		}
+		data.elem[i]=x;
+		track.moved(-1,i);
+		return i;
 	}
 
-public:
-    class Iterator
-    {
-		PriorityQueue<V,C> *a;
-		int pos, last, num;
+	/**
+	 * Restores the heap order of the whole array bottom-up in O(n).
+	 */
+	template <class T>
+	static void heapify(ArrayList<V> &data, C &cmp, T &track) {
+		for (int i=(data.Size+D-2)/D-1; i>=0; --i) siftDown(data,cmp,i,track);
+	}
 
-		void swap1(V &a, V &b) {
-			V c=a;
-			a=b;
-			b=c;
+	/**
+	 * Restores the heap order after the last m of the n elements were
+	 * appended: a batch that is large relative to the heap rebuilds it
+	 * bottom-up in O(n), a small one is sifted up element by element.
+	 */
+	template <class T>
+	static void appended(ArrayList<V> &data, C &cmp, int m, T &track) {
+		int n=data.Size, depth=0;
+		for (int t=n; t>0; t/=D) ++depth;
+		if (2*n<m*depth) {
+			heapify(data,cmp,track);
+		} else {
+			for (int i=n-m; i<n; ++i) siftUp(data,cmp,i,track);
 		}
+	}
 
-		void swap2(bool &a, bool &b) {
-			bool c=a;
-			a=b;
-			b=c;
+	/**
+	 * Removes the element at i by moving the last element into the hole.
+	 * Returns the final index of that element if it had to move above i,
+	 * otherwise -1.
+	 */
+	template <class T>
+	static int removeAt(ArrayList<V> &data, C &cmp, int i, T &track) {
+		int s=data.Size-1;
+		if (i==s) {
+			data.removeIndex(s);
+			return -1;
 		}
+		data.elem[i]=data.elem[s];
+		track.moved(s,i);
+		data.removeIndex(s);
+		if (siftDown(data,cmp,i,track)!=i) return -1;
+		int j=siftUp(data,cmp,i,track);
+		return j!=i?j:-1;
+	}
+};
+
+/*----------------------------------------------------------------------*/
+/**
+* The third template parameter D is the arity of the heap (2 by default).
+* Every node has D consecutive children, so with D=4 or D=8 the heap is
+* shallower and the children looked at by one step of a sift-down sit next
+* to each other in memory, which pays off for large queues.
+*/
+template <class V, class C = Less<V>, int D = 2>
+class PriorityQueue
+{
+	typedef DaryHeap<V,C,D> Heap;
+	typedef typename Heap::NoTrack NoTrack;
+
+	ArrayList<V> data;
+	C cmp;
+
+public:
+    class Iterator
+    {
+		/**
+		 * Keeps the heap indices in forget pointing at their elements while
+		 * a removal moves elements around.
+		 */
+		struct Track {
+			ArrayList<int> *forget;
+			void moved(int from, int to) {
+				for (int k=0; k<forget->Size; ++k) {
+					if (forget->elem[k]==from) {
+						forget->elem[k]=to;
+						return;
+					}
+				}
+			}
+		};
+
+		PriorityQueue<V,C,D> *a;
+		// pos: next index to visit; last: index of the last returned element
+		int pos, last;
+		// heap indices of elements that a removal moved to an index already
+		// visited, and the index of the last one returned (-1 if none)
+		ArrayList<int> forget;
+		int lastForgotten;
 
     public:
-		Iterator(PriorityQueue<V,C> *x) {
+		Iterator(PriorityQueue<V,C,D> *x) {
 		   a=x;
-		   pos=-1;
+		   pos=0;
 		   last=-1;
-		   num=a->Size;
+		   lastForgotten=-1;
+		}
+
+		Iterator(const Iterator &x) : a(x.a), pos(x.pos), last(x.last), forget(x.forget), lastForgotten(x.lastForgotten) {}
+
+		Iterator &operator=(const Iterator &x) {
+			a=x.a;
+			pos=x.pos;
+			last=x.last;
+			forget=x.forget;
+			lastForgotten=x.lastForgotten;
+			return *this;
 		}
 
         /**
          * TODO Returns true if the iteration has more elements.
          */
         bool hasNext() {
-			return num>0;
+			return pos<a->data.Size||forget.Size>0;
 		}
 
         /**
@@ -121,11 +239,14 @@ public:
          */
         const V &next() {
 			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
-			++pos;
-			while (!a->tag.elem[pos]) ++pos;
-			last=pos;
-			--num;
-			return a->data.elem[pos];
+			if (pos<a->data.Size) {
+				last=pos++;
+				return a->data.elem[last];
+			}
+			last=-1;
+			lastForgotten=forget.elem[forget.Size-1];
+			forget.removeIndex(forget.Size-1);
+			return a->data.elem[lastForgotten];
 		}
 
 		/**
@@ -137,23 +258,24 @@ public:
 		 * @throw ElementNotExist
 		 */
 		void remove() {
-			if (last==-1) throw ElementNotExist("\nElement Not Exist\n");
-			int i=last;
-			while (i*2+1<a->data.Size) {
-				if (a->tag.elem[i*2+1]&&(i*2+2>=a->data.Size||a->tag.elem[i*2+2]==0||a->cmp(a->data.elem[i*2+1],a->data.elem[i*2+2]))) {
-					swap1(a->data.elem[i],a->data.elem[i*2+1]);
-					swap2(a->tag.elem[i],a->tag.elem[i*2+1]);
-					i=i*2+1;
-				} else if (i*2+2<a->data.Size&&a->tag.elem[i*2+2]) {
-					swap1(a->data.elem[i],a->data.elem[i*2+2]);
-					swap2(a->tag.elem[i],a->tag.elem[i*2+2]);
-					i=i*2+2;
-				} else break;
+			Track t;
+			t.forget=&forget;
+			if (last!=-1) {
+				int j=Heap::removeAt(a->data,a->cmp,last,t);
+				if (j!=-1) {
+					forget.add(j);
+				} else {
+					pos=last;
+				}
+				last=-1;
+			} else if (lastForgotten!=-1) {
+				// every element still in the heap but those in forget has
+				// been visited, so only forget needs following
+				Heap::removeAt(a->data,a->cmp,lastForgotten,t);
+				lastForgotten=-1;
+			} else {
+				throw ElementNotExist("\nElement Not Exist\n");
 			}
-			a->tag.elem[i]=0;
-			--a->Size;
-			if (i>last) --pos;
-			last=-1;
 		}
     };
 
@@ -161,17 +283,12 @@ public:
      * TODO Constructs an empty priority queue.
      */
     PriorityQueue() {
-		data=ArrayList<V>();
-		tag=ArrayList<bool>();
-		Size=0;
 	}
 
     /**
      * TODO Destructor
      */
     ~PriorityQueue() {
-		data.clear();
-		tag.clear();
 	}
 
     /**
@@ -179,11 +296,7 @@ public:
      */
     PriorityQueue &operator=(const PriorityQueue &x) {
 		if (this!=&x) {
-			data.clear();
 			data=x.data;
-			tag.clear();
-			tag=x.tag;
-			Size=x.Size;
 		}
 		return *this;
 	}
@@ -193,8 +306,6 @@ public:
      */
     PriorityQueue(const PriorityQueue &x) {
 		data=x.data;
-		tag=x.tag;
-		Size=x.Size;
 	}
 
 	/**
@@ -204,23 +315,8 @@ public:
 	 */
 	PriorityQueue(const ArrayList<V> &x) {
 		data=x;
-		for (int i=data.Size/2; i>=0; --i) {
-			int j=i;
-			while (j*2+1<data.Size) {
-				if (j*2+2<data.Size&&cmp(data.elem[j*2+2],data.elem[j])&&cmp(data.elem[j*2+2],data.elem[j*2+1])) {
-					swap1(data.elem[j],data.elem[j*2+2]);
-					j=j*2+2;
-				} else if (cmp(data.elem[j*2+1],data.elem[j])) {
-					swap1(data.elem[j],data.elem[j*2+1]);
-					j=j*2+1;
-				} else break;
-			}
-		}
-		Size=data.Size;
-		tag=ArrayList<bool> ();
-		for (int i=0; i<Size; ++i) {
-			tag.add(tag.Size,1);
-		}
+		NoTrack t;
+		Heap::heapify(data,cmp,t);
 	}
 
     /**
@@ -235,8 +331,6 @@ public:
      */
     void clear() {
 		data.clear();
-		tag.clear();
-		Size=0;
 	}
 
     /**
@@ -245,7 +339,7 @@ public:
      * @throw ElementNotExist
      */
     const V &front() const {
-		if (Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		if (data.Size==0) throw ElementNotExist("\nElement Not Exist\n");
 		return data.elem[0];
 	}
 
@@ -253,24 +347,41 @@ public:
      * TODO Returns true if this PriorityQueue contains no elements.
      */
     bool empty() const {
-		return Size==0;
+		return data.Size==0;
 	}
 
     /**
      * TODO Add an element to the priority queue.
      */
     void push(const V &value) {
-		data.add(data.Size,value);
-		tag.add(tag.Size,1);
-		int i=data.Size-1;
-		while (i) {
-			if (cmp(data.elem[i],data.elem[(i-1)>>1])||tag.elem[(i-1)>>1]==0) {
-				swap1(data.elem[i],data.elem[(i-1)>>1]);
-				swap2(tag.elem[i],tag.elem[(i-1)>>1]);
-			} else break;
-			i=(i-1)>>1;
+		data.add(value);
+		NoTrack t;
+		Heap::siftUp(data,cmp,data.Size-1,t);
+	}
+
+    /**
+     * Adds every element of x. A batch that is large relative to the queue
+     * is appended and the whole heap rebuilt bottom-up in O(n); a small one
+     * is sifted up element by element.
+     */
+    void pushAll(const ArrayList<V> &x) {
+		for (int i=0; i<x.Size; ++i) data.add(x.elem[i]);
+		NoTrack t;
+		Heap::appended(data,cmp,x.Size,t);
+	}
+
+    /**
+     * Removes the k smallest elements (all of them if there are fewer) and
+     * appends them to out in ascending order. Returns the number removed.
+     */
+    int popN(int k, ArrayList<V> &out) {
+		if (k>data.Size) k=data.Size;
+		NoTrack t;
+		for (int i=0; i<k; ++i) {
+			out.add(data.elem[0]);
+			Heap::removeAt(data,cmp,0,t);
 		}
-		++Size;
+		return k<0?0:k;
 	}
 
     /**
@@ -279,28 +390,16 @@ public:
      * @throw ElementNotExist
      */
     void pop() {
-		if (Size==0) throw ElementNotExist("\nElement Not Exist\n");
-		int i=0;
-		while (i*2+1<data.Size) {
-			if (tag.elem[i*2+1]&&(i*2+2>=data.Size||tag.elem[i*2+2]==0||cmp(data.elem[i*2+1],data.elem[i*2+2]))) {
-				swap1(data.elem[i],data.elem[i*2+1]);
-				swap2(tag.elem[i],tag.elem[i*2+1]);
-				i=i*2+1;
-			} else if (i*2+2<data.Size&&tag.elem[i*2+2]) {
-				swap1(data.elem[i],data.elem[i*2+2]);
-				swap2(tag.elem[i],tag.elem[i*2+2]);
-				i=i*2+2;
-			} else break;
-		}
-		tag.elem[i]=0;
-		--Size;
+		if (data.Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		NoTrack t;
+		Heap::removeAt(data,cmp,0,t);
 	}
 
     /**
      * TODO Returns the number of key-value mappings in this map.
      */
     int size() const {
-		return Size;
+		return data.Size;
 	}
 };
 
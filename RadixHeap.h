@@ -0,0 +1,161 @@
+/** @file */
+#ifndef __RADIXHEAP_H
+#define __RADIXHEAP_H
+
+#include "ArrayList.h"
+#include "ElementNotExist.h"
+#include "IndexOutOfBound.h"
+
+/**
+ * Returns the number of significant bits of x (0 for x == 0).
+ */
+inline int significantBits(unsigned long long x) {
+#ifdef __GNUC__
+	return x==0?0:64-__builtin_clzll(x);
+#else
+	int n=0;
+	while (x!=0) {
+		x>>=1;
+		++n;
+	}
+	return n;
+#endif
+}
+
+/**
+ * A radix heap: a monotone priority queue for unsigned integer keys. The
+ * keys popped form a nondecreasing sequence, and pushing a key smaller than
+ * the last popped key is rejected. Within that restriction push is O(1) and
+ * pop is amortized O(log U), where U is the range of Key: every element
+ * moves to a lower bucket at most once per bit of Key, by bit arithmetic
+ * only, never by comparing against other elements.
+ *
+ * Bucket 0 holds the elements whose key equals the last popped key, and
+ * bucket b > 0 the elements whose key first differs from it at bit b-1.
+ *
+ * Elements with equal keys are popped in no particular order.
+ */
+template <class Key, class V>
+class RadixHeap
+{
+	struct item {
+		Key key;
+		V value;
+	};
+	const static int BITS=sizeof(Key)*8;
+
+	ArrayList<item> bucket[BITS+1];
+	Key last;
+	int Size;
+	// location of the current minimum, found lazily (minBucket < 0 if unknown)
+	mutable int minBucket, minIndex;
+
+	int bucketOf(const Key &key) const {
+		return significantBits((unsigned long long)(key^last));
+	}
+
+	void locateMin() const {
+		if (minBucket>=0) return;
+		int b=0;
+		while (bucket[b].Size==0) ++b;
+		int best=bucket[b].Size-1;
+		for (int i=best-1; i>=0&&b>0; --i) {
+			if (bucket[b].elem[i].key<bucket[b].elem[best].key) best=i;
+		}
+		minBucket=b;
+		minIndex=best;
+	}
+
+public:
+    /**
+     * Constructs an empty heap.
+     */
+    RadixHeap() {
+		last=0;
+		Size=0;
+		minBucket=-1;
+	}
+
+    /**
+     * Removes all of the elements and resets the last popped key to 0.
+     */
+    void clear() {
+		for (int b=0; b<=BITS; ++b) bucket[b].clear();
+		last=0;
+		Size=0;
+		minBucket=-1;
+	}
+
+    /**
+     * Returns a const reference to the value with the least key.
+     * @throw ElementNotExist
+     */
+    const V &front() const {
+		if (Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		locateMin();
+		return bucket[minBucket].elem[minIndex].value;
+	}
+
+    /**
+     * Returns the least key.
+     * @throw ElementNotExist
+     */
+    Key frontKey() const {
+		if (Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		locateMin();
+		return bucket[minBucket].elem[minIndex].key;
+	}
+
+    /**
+     * Returns true if this heap contains no elements.
+     */
+    bool empty() const {
+		return Size==0;
+	}
+
+    /**
+     * Adds value with the specified key.
+     * @throw IndexOutOfBound if key is smaller than the last popped key
+     */
+    void push(const Key &key, const V &value) {
+		if (key<last) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		item x;
+		x.key=key;
+		x.value=value;
+		int b=bucketOf(key);
+		bucket[b].add(x);
+		if (minBucket>=0&&key<bucket[minBucket].elem[minIndex].key) {
+			minBucket=b;
+			minIndex=bucket[b].Size-1;
+		}
+		++Size;
+	}
+
+    /**
+     * Removes the element with the least key.
+     * @throw ElementNotExist
+     */
+    void pop() {
+		if (Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		locateMin();
+		ArrayList<item> &cur=bucket[minBucket];
+		last=cur.elem[minIndex].key;
+		cur.elem[minIndex]=cur.elem[cur.Size-1];
+		--cur.Size;
+		--Size;
+		if (minBucket>0) {
+			for (int i=0; i<cur.Size; ++i) bucket[bucketOf(cur.elem[i].key)].add(cur.elem[i]);
+			cur.Size=0;
+		}
+		minBucket=-1;
+	}
+
+    /**
+     * Returns the number of elements in this heap.
+     */
+    int size() const {
+		return Size;
+	}
+};
+
+#endif
@@ -0,0 +1,175 @@
+/** @file */
+#ifndef __TIMERWHEEL_H
+#define __TIMERWHEEL_H
+
+#include "RadixHeap.h"
+
+/**
+ * A hierarchical timer wheel: a monotone priority queue for unsigned
+ * integer keys (timestamps) with the interface of RadixHeap. There is one
+ * wheel of 256 slots per byte of Key. An element sits on the wheel of the
+ * highest byte in which its key differs from the last popped key, in the
+ * slot given by that byte. Popping moves the current time forward and
+ * cascades the elements of the slot it came from down to finer wheels.
+ *
+ * Compared to RadixHeap, each element cascades at most once per byte
+ * instead of once per bit, and an occupancy bitmap per wheel finds the
+ * next non-empty slot in a few word operations.
+ *
+ * Elements with equal keys are popped in no particular order.
+ */
+template <class Key, class V>
+class TimerWheel
+{
+	struct item {
+		Key key;
+		V value;
+	};
+	const static int LEVELS=sizeof(Key);
+
+	// slot[l*256+s] is created on first use
+	ArrayList<item> *slot[LEVELS*256];
+	unsigned long long occ[LEVELS][4];
+	Key cur;
+	int Size;
+	mutable int minLevel, minSlot, minIndex;
+
+	int levelOf(const Key &key) const {
+		int b=significantBits((unsigned long long)(key^cur));
+		return b==0?0:(b-1)/8;
+	}
+
+	void place(const item &x) {
+		int l=levelOf(x.key), s=(int)((unsigned long long)x.key>>(8*l))&255;
+		ArrayList<item> *&tmp=slot[l*256+s];
+		if (tmp==NULL) tmp=new ArrayList<item>();
+		tmp->add(x);
+		occ[l][s>>6]|=1ULL<<(s&63);
+	}
+
+	int lowestSlot(int l) const {
+		for (int w=0; w<4; ++w) {
+			if (occ[l][w]!=0) return w*64+significantBits(occ[l][w]&(~occ[l][w]+1))-1;
+		}
+		return -1;
+	}
+
+	void locateMin() const {
+		if (minLevel>=0) return;
+		int l=0, s;
+		while ((s=lowestSlot(l))<0) ++l;
+		ArrayList<item> &tmp=*slot[l*256+s];
+		int best=tmp.Size-1;
+		for (int i=best-1; i>=0&&l>0; --i) {
+			if (tmp.elem[i].key<tmp.elem[best].key) best=i;
+		}
+		minLevel=l;
+		minSlot=s;
+		minIndex=best;
+	}
+
+	TimerWheel(const TimerWheel &);
+	TimerWheel &operator=(const TimerWheel &);
+
+public:
+    /**
+     * Constructs an empty wheel at time 0.
+     */
+    TimerWheel() {
+		for (int i=0; i<LEVELS*256; ++i) slot[i]=NULL;
+		for (int l=0; l<LEVELS; ++l) occ[l][0]=occ[l][1]=occ[l][2]=occ[l][3]=0;
+		cur=0;
+		Size=0;
+		minLevel=-1;
+	}
+
+    /**
+     * Destructor
+     */
+    ~TimerWheel() {
+		for (int i=0; i<LEVELS*256; ++i) delete slot[i];
+	}
+
+    /**
+     * Removes all of the elements and resets the time to 0.
+     */
+    void clear() {
+		for (int i=0; i<LEVELS*256; ++i) {
+			if (slot[i]!=NULL) slot[i]->Size=0;
+		}
+		for (int l=0; l<LEVELS; ++l) occ[l][0]=occ[l][1]=occ[l][2]=occ[l][3]=0;
+		cur=0;
+		Size=0;
+		minLevel=-1;
+	}
+
+    /**
+     * Returns a const reference to the value with the least key.
+     * @throw ElementNotExist
+     */
+    const V &front() const {
+		if (Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		locateMin();
+		return slot[minLevel*256+minSlot]->elem[minIndex].value;
+	}
+
+    /**
+     * Returns the least key.
+     * @throw ElementNotExist
+     */
+    Key frontKey() const {
+		if (Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		locateMin();
+		return slot[minLevel*256+minSlot]->elem[minIndex].key;
+	}
+
+    /**
+     * Returns true if this wheel contains no elements.
+     */
+    bool empty() const {
+		return Size==0;
+	}
+
+    /**
+     * Adds value with the specified key.
+     * @throw IndexOutOfBound if key is smaller than the last popped key
+     */
+    void push(const Key &key, const V &value) {
+		if (key<cur) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		item x;
+		x.key=key;
+		x.value=value;
+		place(x);
+		++Size;
+		if (minLevel>=0&&key<slot[minLevel*256+minSlot]->elem[minIndex].key) minLevel=-1;
+	}
+
+    /**
+     * Removes the element with the least key, advancing the time to its key.
+     * @throw ElementNotExist
+     */
+    void pop() {
+		if (Size==0) throw ElementNotExist("\nElement Not Exist\n");
+		locateMin();
+		ArrayList<item> &tmp=*slot[minLevel*256+minSlot];
+		cur=tmp.elem[minIndex].key;
+		tmp.elem[minIndex]=tmp.elem[tmp.Size-1];
+		--tmp.Size;
+		--Size;
+		if (minLevel>0) {
+			for (int i=0; i<tmp.Size; ++i) place(tmp.elem[i]);
+			tmp.Size=0;
+		}
+		if (tmp.Size==0) occ[minLevel][minSlot>>6]&=~(1ULL<<(minSlot&63));
+		minLevel=-1;
+	}
+
+    /**
+     * Returns the number of elements in this wheel.
+     */
+    int size() const {
+		return Size;
+	}
+};
+
+#endif
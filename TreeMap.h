@@ -3,13 +3,52 @@
 #define __TREEMAP_H
 
 #include "ElementNotExist.h"
+#include "IndexOutOfBound.h"
+#include "ArrayList.h"
 #include <cstdlib>
+#include <ctime>
+
+/**
+ * Default augmentation of TreeMap: maintains nothing.
+ *
+ * An augmentation is a monoid over the values. It defines the type value,
+ * identity(), of(v) mapping one mapped value into the monoid, and an
+ * associative combine(a, b). TreeMap keeps the combination of every subtree,
+ * and aggregate(lo, hi) combines the mappings of a key range in key order.
+ */
+template <class V>
+class NoAugment
+{
+public:
+    struct value {};
+    static value identity() { return value(); }
+    static value of(const V &) { return value(); }
+    static value combine(const value &, const value &) { return value(); }
+};
+
+/**
+ * Augmentation of TreeMap summing the values with operator+.
+ * V(0) must be the neutral element.
+ */
+template <class V>
+class SumAugment
+{
+public:
+    typedef V value;
+    static value identity() { return V(0); }
+    static value of(const V &v) { return v; }
+    static value combine(const value &a, const value &b) { return a+b; }
+};
 
 /**
  * TreeMap is the balanced-tree implementation of map. The iterators must
  * iterate through the map in the natural order (operator<) of the key.
+ *
+ * Every node also stores the size of its subtree, which gives rank(),
+ * select() and countRange() in O(log n), and the combination of its subtree
+ * under the augmentation M, which gives aggregate() in O(log n).
  */
-template<class K, class V>
+template<class K, class V, class M = NoAugment<V> >
 class TreeMap
 {
 public:
@@ -39,17 +78,48 @@ public:
 		}
     };
 
+	typedef typename M::value Agg;
+
 	struct node {
 		node *son[2], *fa;
 		Entry data;
 		int tag;
-		node (node *fa, Entry data, int tag) : fa(fa), data(data), tag(tag) {
+		// size and augmentation of the subtree rooted here
+		int cnt;
+		Agg agg;
+		node (node *fa, Entry data, int tag) : fa(fa), data(data), tag(tag), cnt(1), agg(M::of(data.GetValue())) {
 			son[0]=son[1]=NULL;
 		}
 	} *root;
 	int Size;
+	// state of this map's own priority generator (splitmix64)
+	unsigned long long seed;
 
-	int child(node *cur) {
+	int priority() {
+		unsigned long long z=(seed+=0x9E3779B97F4A7C15ULL);
+		z=(z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+		z=(z^(z>>27))*0x94D049BB133111EBULL;
+		return (int)((z^(z>>31))>>33);
+	}
+
+	static int count(node *cur) {
+		return cur==NULL?0:cur->cnt;
+	}
+
+	static Agg sum(node *cur) {
+		return cur==NULL?M::identity():cur->agg;
+	}
+
+	static void pull(node *cur) {
+		cur->cnt=count(cur->son[0])+1+count(cur->son[1]);
+		cur->agg=M::combine(M::combine(sum(cur->son[0]),M::of(cur->data.GetValue())),sum(cur->son[1]));
+	}
+
+	static void pullUp(node *cur) {
+		for (; cur!=NULL; cur=cur->fa) pull(cur);
+	}
+
+	static int child(node *cur) {
 		return cur->fa->son[0]!=cur;
 	}
 
@@ -67,140 +137,359 @@ public:
 		}
 		tmp->fa=cur;
 		cur->son[1^idx]=tmp;
+		pull(tmp);
+		pull(cur);
 	}
 
-	void clean(node *cur) {
-		if (cur->son[0]!=NULL) clean(cur->son[0]);
-		if (cur->son[1]!=NULL) clean(cur->son[1]);
-		delete cur;
+	/**
+	 * Deletes the whole subtree of cur without recursion, unlinking leaves
+	 * bottom-up.
+	 */
+	static void clean(node *cur) {
+		if (cur==NULL) return;
+		node *stop=cur->fa;
+		while (cur!=stop) {
+			if (cur->son[0]!=NULL) {
+				cur=cur->son[0];
+			} else if (cur->son[1]!=NULL) {
+				cur=cur->son[1];
+			} else {
+				node *tmp=cur->fa;
+				if (tmp!=stop) tmp->son[child(cur)]=NULL;
+				delete cur;
+				cur=tmp;
+			}
+		}
 	}
 
-	void dfs(node *cur, node *x) {
-		node *tmp;
-		if (cur==NULL) {
-			tmp=new node(NULL,x->data,x->tag);
-			root=tmp;
-		} else {
-			tmp=new node(cur,x->data,x->tag);
-			cur->son[child(x)]=tmp;
+	/**
+	 * Makes root a copy of the tree rooted at x, without recursion: the
+	 * source and the copy are walked in lockstep, and a missing child in
+	 * the copy marks a subtree not visited yet.
+	 */
+	void dfs(node *x) {
+		root=new node(NULL,x->data,x->tag);
+		node *cur=root;
+		cur->cnt=x->cnt;
+		cur->agg=x->agg;
+		while (x!=NULL) {
+			int k=(x->son[0]!=NULL&&cur->son[0]==NULL)?0:1;
+			if (x->son[k]!=NULL&&cur->son[k]==NULL) {
+				x=x->son[k];
+				cur->son[k]=new node(cur,x->data,x->tag);
+				cur=cur->son[k];
+				cur->cnt=x->cnt;
+				cur->agg=x->agg;
+			} else {
+				x=x->fa;
+				cur=cur->fa;
+			}
 		}
-		if (x->son[0]!=NULL) dfs(tmp,x->son[0]);
-		if (x->son[1]!=NULL) dfs(tmp,x->son[1]);
 	}
 
-	bool find1(node *cur, const K &key) const {
-		if (cur==NULL) return 0;
-		if (cur->data.getKey()==key) return 1;
-		if (cur->data.getKey()<key) {
-			return find1(cur->son[1],key);
-		} else {
-			return find1(cur->son[0],key);
+	static node *first(node *cur) {
+		while (cur->son[0]!=NULL) cur=cur->son[0];
+		return cur;
+	}
+
+	static node *last(node *cur) {
+		while (cur->son[1]!=NULL) cur=cur->son[1];
+		return cur;
+	}
+
+	static node *succ(node *cur) {
+		if (cur->son[1]!=NULL) return first(cur->son[1]);
+		while (cur->fa!=NULL&&cur->fa->son[1]==cur) cur=cur->fa;
+		return cur->fa;
+	}
+
+	static node *pred(node *cur) {
+		if (cur->son[0]!=NULL) return last(cur->son[0]);
+		while (cur->fa!=NULL&&cur->fa->son[0]==cur) cur=cur->fa;
+		return cur->fa;
+	}
+
+	/**
+	 * Returns the node with the least key greater than or equal to key
+	 * (strictly greater if strict), or NULL.
+	 */
+	node *ceil(const K &key, bool strict) const {
+		node *cur=root, *res=NULL;
+		while (cur!=NULL) {
+			if (key<cur->data.getKey()||(!strict&&!(cur->data.getKey()<key))) {
+				res=cur;
+				cur=cur->son[0];
+			} else {
+				cur=cur->son[1];
+			}
 		}
+		return res;
 	}
 
-	bool find2(node *cur, const V &value) const {
-		if (cur==NULL) return 0;
-		if (cur->data.getValue()==value) return 1;
-		return find2(cur->son[0],value)|find2(cur->son[1],value);
+	/**
+	 * Returns the node with the greatest key less than or equal to key
+	 * (strictly less if strict), or NULL.
+	 */
+	node *floor(const K &key, bool strict) const {
+		node *cur=root, *res=NULL;
+		while (cur!=NULL) {
+			if (cur->data.getKey()<key||(!strict&&!(key<cur->data.getKey()))) {
+				res=cur;
+				cur=cur->son[1];
+			} else {
+				cur=cur->son[0];
+			}
+		}
+		return res;
 	}
 
-	V &keyValue(node *cur, K key) const {
-		if (cur->data.getKey()==key) return cur->data.GetValue();
-		if (key<cur->data.getKey()) {
-			return keyValue(cur->son[0],key);
-		} else {
-			return keyValue(cur->son[1],key);
+	static K keyOf(node *cur) {
+		if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return cur->data.getKey();
+	}
+
+	node *find(const K &key) const {
+		node *cur=root;
+		while (cur!=NULL) {
+			if (key<cur->data.getKey()) {
+				cur=cur->son[0];
+			} else if (cur->data.getKey()<key) {
+				cur=cur->son[1];
+			} else {
+				return cur;
+			}
 		}
+		return NULL;
 	}
 
-	void insert(node *cur, Entry x) {
-		node *tmp=NULL;
-		if (cur==NULL) {
-			++Size;
-			tmp=new node(NULL,x,rand());
-			root=tmp;
-		} else {
+	void insert(const Entry &x) {
+		node *cur=root, *fa=NULL;
+		int k=0;
+		while (cur!=NULL) {
 			if (x.getKey()<cur->data.getKey()) {
-				if (cur->son[0]==NULL) {
-					tmp=new node(cur,x,rand());
-					++Size;
-					cur->son[0]=tmp;
-				} else {
-					insert(cur->son[0],x);
-				}
+				k=0;
 			} else if (cur->data.getKey()<x.getKey()) {
-				if (cur->son[1]==NULL) {
-					tmp=new node(cur,x,rand());
-					++Size;
-					cur->son[1]=tmp;
-				} else {
-					insert(cur->son[1],x);
-				}
+				k=1;
 			} else {
 				cur->data=x;
+				pullUp(cur);
+				return;
 			}
+			fa=cur;
+			cur=cur->son[k];
 		}
-		if (tmp!=NULL) {
-			while (tmp->fa!=NULL) {
-				if (tmp->tag>tmp->fa->tag) {
-					rotate(tmp);
-				} else {
-					break;
-				}
+		cur=new node(fa,x,priority());
+		if (fa!=NULL) {
+			fa->son[k]=cur;
+		} else {
+			root=cur;
+		}
+		++Size;
+		pullUp(fa);
+		while (cur->fa!=NULL&&cur->tag>cur->fa->tag) rotate(cur);
+	}
+
+	/**
+	 * Rotates cur down to a leaf and deletes it.
+	 */
+	void del(node *cur) {
+		while (cur->son[0]!=NULL||cur->son[1]!=NULL) {
+			if (cur->son[0]!=NULL&&(cur->son[1]==NULL||cur->son[1]->tag<cur->son[0]->tag)) {
+				rotate(cur->son[0]);
+			} else {
+				rotate(cur->son[1]);
 			}
 		}
+		if (cur->fa!=NULL) {
+			cur->fa->son[child(cur)]=NULL;
+			pullUp(cur->fa);
+		} else {
+			root=NULL;
+		}
+		delete cur;
+		--Size;
 	}
 
-	void del(node *cur, K key) {
-		if (cur->data.getKey()==key) {
-			while (cur->son[0]!=NULL||cur->son[1]!=NULL) {
-				if (cur->son[0]!=NULL&&(cur->son[1]==NULL||cur->son[1]->tag<cur->son[0]->tag)) {
-					rotate(cur->son[0]);
-				} else {
-					rotate(cur->son[1]);
-				}
+	/**
+	 * Splits the tree cur into l (keys less than key) and r (keys greater
+	 * than key) along the search path, and returns the detached node whose
+	 * key equals key, or NULL.
+	 */
+	static node *splitNode(node *cur, const K &key, node *&l, node *&r) {
+		node **lp=&l, **rp=&r, *lfa=NULL, *rfa=NULL, *eq=NULL;
+		while (cur!=NULL) {
+			if (cur->data.getKey()<key) {
+				*lp=cur;
+				cur->fa=lfa;
+				lfa=cur;
+				lp=&cur->son[1];
+				cur=cur->son[1];
+			} else if (key<cur->data.getKey()) {
+				*rp=cur;
+				cur->fa=rfa;
+				rfa=cur;
+				rp=&cur->son[0];
+				cur=cur->son[0];
+			} else {
+				eq=cur;
+				break;
 			}
-			if (cur->fa!=NULL) {
-				cur->fa->son[child(cur)]=NULL;
+		}
+		*lp=(eq==NULL?NULL:eq->son[0]);
+		*rp=(eq==NULL?NULL:eq->son[1]);
+		if (*lp!=NULL) (*lp)->fa=lfa;
+		if (*rp!=NULL) (*rp)->fa=rfa;
+		if (eq!=NULL) {
+			eq->son[0]=eq->son[1]=eq->fa=NULL;
+			pull(eq);
+		}
+		pullUp(lfa);
+		pullUp(rfa);
+		return eq;
+	}
+
+	/**
+	 * Joins the trees a and b, where every key of a is less than every key
+	 * of b, along their inner spines.
+	 */
+	static node *mergeNode(node *a, node *b) {
+		node *res=NULL, **p=&res, *fa=NULL;
+		while (a!=NULL&&b!=NULL) {
+			if (a->tag>b->tag) {
+				*p=a;
+				a->fa=fa;
+				fa=a;
+				p=&a->son[1];
+				a=a->son[1];
 			} else {
-				root=NULL;
+				*p=b;
+				b->fa=fa;
+				fa=b;
+				p=&b->son[0];
+				b=b->son[0];
 			}
-			delete cur;
-		} else if (key<cur->data.getKey()) {
-			del(cur->son[0],key);
+		}
+		*p=(a!=NULL?a:b);
+		if (*p!=NULL) (*p)->fa=fa;
+		pullUp(fa);
+		return res;
+	}
+
+	static void link(node *cur, node *l, node *r) {
+		cur->son[0]=l;
+		cur->son[1]=r;
+		if (l!=NULL) l->fa=cur;
+		if (r!=NULL) r->fa=cur;
+		pull(cur);
+	}
+
+	/**
+	 * The set operations below pivot on whichever root has the higher
+	 * priority and split the other tree by its key, so they recurse to the
+	 * expected O(log n) depth of the treap.
+	 */
+
+	// keys of a or b; b's value wins
+	static node *unite(node *a, node *b) {
+		if (a==NULL) return b;
+		if (b==NULL) return a;
+		node *l, *r, *eq;
+		if (a->tag>b->tag) {
+			eq=splitNode(b,a->data.getKey(),l,r);
+			if (eq!=NULL) {
+				a->data=eq->data;
+				delete eq;
+			}
+			node *a0=a->son[0], *a1=a->son[1];
+			link(a,unite(a0,l),unite(a1,r));
+			return a;
+		}
+		eq=splitNode(a,b->data.getKey(),l,r);
+		delete eq;
+		node *b0=b->son[0], *b1=b->son[1];
+		link(b,unite(l,b0),unite(r,b1));
+		return b;
+	}
+
+	// keys of both a and b; a's value wins
+	static node *intersect(node *a, node *b) {
+		if (a==NULL||b==NULL) {
+			clean(a);
+			clean(b);
+			return NULL;
+		}
+		node *l, *r, *eq, *top;
+		if (a->tag>b->tag) {
+			top=a;
+			eq=splitNode(b,a->data.getKey(),l,r);
+			node *a0=a->son[0], *a1=a->son[1];
+			l=intersect(a0,l);
+			r=intersect(a1,r);
 		} else {
-			del(cur->son[1],key);
+			top=b;
+			eq=splitNode(a,b->data.getKey(),l,r);
+			if (eq!=NULL) b->data=eq->data;
+			node *b0=b->son[0], *b1=b->son[1];
+			l=intersect(l,b0);
+			r=intersect(r,b1);
+		}
+		if (eq==NULL) {
+			delete top;
+			return mergeNode(l,r);
+		}
+		delete eq;
+		link(top,l,r);
+		return top;
+	}
+
+	// keys of a that are not in b
+	static node *subtract(node *a, node *b) {
+		if (a==NULL||b==NULL) {
+			clean(b);
+			return a;
+		}
+		node *l, *r, *eq;
+		if (a->tag>b->tag) {
+			eq=splitNode(b,a->data.getKey(),l,r);
+			node *a0=a->son[0], *a1=a->son[1];
+			l=subtract(a0,l);
+			r=subtract(a1,r);
+			if (eq==NULL) {
+				link(a,l,r);
+				return a;
+			}
+			delete eq;
+			delete a;
+			return mergeNode(l,r);
 		}
+		eq=splitNode(a,b->data.getKey(),l,r);
+		delete eq;
+		node *b0=b->son[0], *b1=b->son[1];
+		l=subtract(l,b0);
+		r=subtract(r,b1);
+		delete b;
+		return mergeNode(l,r);
+	}
+
+	void setRoot(node *cur) {
+		root=cur;
+		if (root!=NULL) root->fa=NULL;
+		Size=count(root);
 	}
 
     class Iterator
     {
-		node *root, *cur;
+		// nxt is the node next() returns; the iteration ends on reaching stop
+		node *nxt, *stop;
+		bool desc;
     public:
-		Iterator(node *root) : root(root) {
-			cur=NULL;
-		}
-		int child(node *cur) {
-			return cur->fa->son[0]!=cur;
-		}
+		Iterator(node *nxt, node *stop, bool desc) : nxt(nxt), stop(stop), desc(desc) {}
+
         /**
          * TODO Returns true if the iteration has more elements.
          */
         bool hasNext() {
-			node *tmp=cur;
-			if (tmp==NULL) {
-				if (root==NULL) {
-					return 0;
-				} else {
-					return 1;
-				}
-			}
-			if (tmp->son[1]!=NULL) return 1;
-			while (tmp->fa!=NULL&&child(tmp)==1) {
-				tmp=tmp->fa;
-			}
-			if (tmp->fa!=NULL) return 1;
-			return 0;
+			return nxt!=stop;
 		}
 
         /**
@@ -209,29 +498,28 @@ public:
          */
         const Entry &next() {
 			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
-			if (cur==NULL) {
-				cur=root;
-				while (cur->son[0]!=NULL) cur=cur->son[0];
-				return cur->data;
-			}
-			if (cur->son[1]!=NULL) {
-				cur=cur->son[1];
-				while (cur->son[0]!=NULL) cur=cur->son[0];
-				return cur->data;
-			}
-			while (cur->fa!=NULL&&child(cur)==1) {
-				cur=cur->fa;
-			}
-			cur=cur->fa;
+			node *cur=nxt;
+			nxt=desc?pred(cur):succ(cur);
 			return cur->data;
 		}
     };
 
     /**
      * TODO Constructs an empty tree map.
+     * Priorities come from a generator owned by the map, seeded from the
+     * clock and the map's address, so maps never share or reseed rand().
      */
     TreeMap() {
-		srand(time(0));
+		seed=(unsigned long long)time(0)*0x9E3779B97F4A7C15ULL^(unsigned long long)(size_t)this;
+		Size=0;
+		root=NULL;
+	}
+
+    /**
+     * Constructs an empty tree map whose priorities are drawn from the given
+     * seed, so the same sequence of operations always builds the same tree.
+     */
+    explicit TreeMap(unsigned long long seed) : seed(seed) {
 		Size=0;
 		root=NULL;
 	}
@@ -249,7 +537,7 @@ public:
 		if (this!=&x) {
 			if (root!=NULL) clean(root);
 			root=NULL;
-			if (x.root!=NULL) dfs(root,x.root);
+			if (x.root!=NULL) dfs(x.root);
 			Size=x.Size;
 		}
 		return *this;
@@ -258,9 +546,9 @@ public:
     /**
      * TODO Copy-constructor
      */
-    TreeMap(const TreeMap &x) {
+    TreeMap(const TreeMap &x) : seed(x.seed^(unsigned long long)(size_t)this) {
 		root=NULL;
-		if (x.root!=NULL) dfs(root,x.root);
+		if (x.root!=NULL) dfs(x.root);
 		Size=x.Size;
 	}
 
@@ -268,7 +556,24 @@ public:
      * TODO Returns an iterator over the elements in this map.
      */
     Iterator iterator() const {
-		return Iterator(root);
+		return Iterator(root==NULL?NULL:first(root),NULL,false);
+	}
+
+    /**
+     * Returns an iterator over the mappings whose keys lie in [from, to), in
+     * ascending order. Seeking costs O(log n); each step is amortized O(1).
+     */
+    Iterator iterator(const K &from, const K &to) const {
+		if (!(from<to)) return Iterator(NULL,NULL,false);
+		return Iterator(ceil(from,false),ceil(to,false),false);
+	}
+
+    /**
+     * Returns an iterator over the elements in this map in descending key
+     * order.
+     */
+    Iterator descendingIterator() const {
+		return Iterator(root==NULL?NULL:last(root),NULL,true);
 	}
 
     /**
@@ -284,14 +589,17 @@ public:
      * TODO Returns true if this map contains a mapping for the specified key.
      */
     bool containsKey(const K &key) const {
-		return find1(root,key);
+		return find(key)!=NULL;
 	}
 
     /**
      * TODO Returns true if this map maps one or more keys to the specified value.
      */
     bool containsValue(const V &value) const {
-		return find2(root,value);
+		for (node *cur=(root==NULL?NULL:first(root)); cur!=NULL; cur=succ(cur)) {
+			if (cur->data.getValue()==value) return true;
+		}
+		return false;
 	}
 
     /**
@@ -300,8 +608,9 @@ public:
      * @throw ElementNotExist
      */
     const V &get(const K &key) const {
-		if (!containsKey(key)) throw ElementNotExist("\nElement Not Exist\n");
-		return keyValue(root,key);
+		node *cur=find(key);
+		if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return cur->data.GetValue();
 	}
 
     /**
@@ -315,7 +624,7 @@ public:
      * TODO Associates the specified value with the specified key in this map.
      */
     void put(const K &key, const V &value) {
-		insert(root,Entry(key,value));
+		insert(Entry(key,value));
 	}
 
     /**
@@ -324,9 +633,248 @@ public:
      * @throw ElementNotExist
      */
     void remove(const K &key) {
-		if (!containsKey(key)) throw ElementNotExist("\nElement Not Exist\n");
-		del(root,key);
-		--Size;
+		node *cur=find(key);
+		if (cur==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		del(cur);
+	}
+
+    /**
+     * Returns the least key in this map.
+     * @throw ElementNotExist if the map is empty
+     */
+    K firstKey() const {
+		return keyOf(root==NULL?NULL:first(root));
+	}
+
+    /**
+     * Returns the greatest key in this map.
+     * @throw ElementNotExist if the map is empty
+     */
+    K lastKey() const {
+		return keyOf(root==NULL?NULL:last(root));
+	}
+
+    /**
+     * Returns the greatest key less than or equal to key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K floorKey(const K &key) const {
+		return keyOf(floor(key,false));
+	}
+
+    /**
+     * Returns the least key greater than or equal to key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K ceilingKey(const K &key) const {
+		return keyOf(ceil(key,false));
+	}
+
+    /**
+     * Returns the greatest key strictly less than key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K lowerKey(const K &key) const {
+		return keyOf(floor(key,true));
+	}
+
+    /**
+     * Returns the least key strictly greater than key.
+     * @throw ElementNotExist if there is no such key
+     */
+    K higherKey(const K &key) const {
+		return keyOf(ceil(key,true));
+	}
+
+    /**
+     * Returns the number of keys strictly less than key, in O(log n).
+     */
+    int rank(const K &key) const {
+		int res=0;
+		for (node *cur=root; cur!=NULL; ) {
+			if (cur->data.getKey()<key) {
+				res+=count(cur->son[0])+1;
+				cur=cur->son[1];
+			} else {
+				cur=cur->son[0];
+			}
+		}
+		return res;
+	}
+
+    /**
+     * Returns the mapping with the k-th least key, counting from 0, in
+     * O(log n).
+     * @throw IndexOutOfBound
+     */
+    const Entry &select(int k) const {
+		if (k<0||k>=Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		node *cur=root;
+		while (k!=count(cur->son[0])) {
+			if (k<count(cur->son[0])) {
+				cur=cur->son[0];
+			} else {
+				k-=count(cur->son[0])+1;
+				cur=cur->son[1];
+			}
+		}
+		return cur->data;
+	}
+
+    /**
+     * Returns the number of keys in [lo, hi), in O(log n).
+     */
+    int countRange(const K &lo, const K &hi) const {
+		if (!(lo<hi)) return 0;
+		return rank(hi)-rank(lo);
+	}
+
+    /**
+     * Returns the combination under M of the values whose keys lie in
+     * [lo, hi), in key order, in O(log n).
+     */
+    Agg aggregate(const K &lo, const K &hi) const {
+		if (!(lo<hi)) return M::identity();
+		// descend to the topmost node inside the range
+		node *cur=root;
+		while (cur!=NULL) {
+			if (cur->data.getKey()<lo) {
+				cur=cur->son[1];
+			} else if (!(cur->data.getKey()<hi)) {
+				cur=cur->son[0];
+			} else {
+				break;
+			}
+		}
+		if (cur==NULL) return M::identity();
+		// keys >= lo in its left subtree, keys < hi in its right subtree
+		Agg left=M::identity(), right=M::identity();
+		for (node *x=cur->son[0]; x!=NULL; ) {
+			if (x->data.getKey()<lo) {
+				x=x->son[1];
+			} else {
+				left=M::combine(M::combine(M::of(x->data.GetValue()),sum(x->son[1])),left);
+				x=x->son[0];
+			}
+		}
+		for (node *x=cur->son[1]; x!=NULL; ) {
+			if (x->data.getKey()<hi) {
+				right=M::combine(right,M::combine(sum(x->son[0]),M::of(x->data.GetValue())));
+				x=x->son[1];
+			} else {
+				x=x->son[0];
+			}
+		}
+		return M::combine(M::combine(left,M::of(cur->data.GetValue())),right);
+	}
+
+    /**
+     * Replaces the contents of this map with keys[i] -> values[i], in O(n).
+     * The keys must be in ascending order; of equal keys the last one wins.
+     * The treap is built as a Cartesian tree over the rightmost path, with
+     * no key comparisons beyond the check of each key against the previous.
+     * @throw IndexOutOfBound if keys and values differ in size, or if a key
+     * is less than the previous one, in which case the map is left empty
+     */
+    void fromSorted(const ArrayList<K> &keys, const ArrayList<V> &values) {
+		if (keys.Size!=values.Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		clear();
+		node *tail=NULL;
+		for (int i=0; i<keys.Size; ++i) {
+			if (tail!=NULL&&!(tail->data.getKey()<keys.elem[i])) {
+				if (keys.elem[i]<tail->data.getKey()) {
+					clear();
+					throw IndexOutOfBound("\nIndex Out Of Bound\n");
+				}
+				tail->data=Entry(keys.elem[i],values.elem[i]);
+				continue;
+			}
+			node *cur=new node(NULL,Entry(keys.elem[i],values.elem[i]),priority());
+			// pop the rightmost path up to the first node of higher priority;
+			// popped nodes are complete and become cur's left subtree
+			node *sub=NULL;
+			while (tail!=NULL&&tail->tag<cur->tag) {
+				pull(tail);
+				sub=tail;
+				tail=tail->fa;
+			}
+			cur->son[0]=sub;
+			if (sub!=NULL) sub->fa=cur;
+			cur->fa=tail;
+			if (tail!=NULL) {
+				tail->son[1]=cur;
+			} else {
+				root=cur;
+			}
+			tail=cur;
+		}
+		pullUp(tail);
+		Size=count(root);
+	}
+
+    /**
+     * Moves the mappings whose keys are greater than or equal to key into
+     * right, replacing its contents, in expected O(log n).
+     */
+    void split(const K &key, TreeMap &right) {
+		if (&right==this) return;
+		right.clear();
+		node *l, *r, *eq=splitNode(root,key,l,r);
+		setRoot(l);
+		right.setRoot(eq==NULL?r:mergeNode(eq,r));
+	}
+
+    /**
+     * Moves every mapping of right into this map in expected O(log n),
+     * leaving right empty. Every key of right must be greater than every
+     * key of this map; otherwise this falls back to unionWith(right).
+     */
+    void join(TreeMap &right) {
+		if (&right==this||right.root==NULL) return;
+		if (root!=NULL&&!(last(root)->data.getKey()<first(right.root)->data.getKey())) {
+			unionWith(right);
+			return;
+		}
+		setRoot(mergeNode(root,right.root));
+		right.root=NULL;
+		right.Size=0;
+	}
+
+    /**
+     * Moves every mapping of other into this map, leaving other empty.
+     * Where both maps have a key, other's value wins, as with put.
+     * Takes expected O(m log(n/m + 1)) for sizes m <= n.
+     */
+    void unionWith(TreeMap &other) {
+		if (&other==this) return;
+		setRoot(unite(root,other.root));
+		other.root=NULL;
+		other.Size=0;
+	}
+
+    /**
+     * Keeps only the keys also present in other, with this map's values,
+     * and empties other. Takes expected O(m log(n/m + 1)).
+     */
+    void intersectWith(TreeMap &other) {
+		if (&other==this) return;
+		setRoot(intersect(root,other.root));
+		other.root=NULL;
+		other.Size=0;
+	}
+
+    /**
+     * Removes the keys present in other, and empties other.
+     * Takes expected O(m log(n/m + 1)).
+     */
+    void difference(TreeMap &other) {
+		if (&other==this) {
+			clear();
+			return;
+		}
+		setRoot(subtract(root,other.root));
+		other.root=NULL;
+		other.Size=0;
 	}
 
     /**
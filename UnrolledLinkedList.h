@@ -0,0 +1,421 @@
+/** @file */
+#ifndef __UNROLLEDLINKEDLIST_H
+#define __UNROLLEDLINKEDLIST_H
+
+#include "IndexOutOfBound.h"
+#include "ElementNotExist.h"
+#include <cstddef>
+
+/**
+ * An unrolled linked list: a doubly linked list whose nodes each hold up to
+ * B elements in an array. It has the interface of LinkedList, but scanning
+ * touches one node per B elements, and the per-element pointer overhead is
+ * divided by B. A full node is split in two on insertion; a node that falls
+ * below a quarter full after a removal pulls elements from its successor, or
+ * merges with it.
+ *
+ * The iterator iterates in the order of the elements being loaded into this list.
+ */
+template <class T, int B = 32>
+class UnrolledLinkedList
+{
+	struct node {
+		T data[B];
+		int cnt;
+		node *pre, *next;
+		node(node *pre=NULL, node *next=NULL) : cnt(0), pre(pre), next(next) {}
+	} *front, *rear;
+	int Size;
+
+	/**
+	 * Finds the node holding the element at index and stores the offset of
+	 * the element inside that node in off. Walks from the nearer end.
+	 */
+	node *locate(int index, int &off) const {
+		node *tmp;
+		if (index<Size/2) {
+			for (tmp=front; index>=tmp->cnt; tmp=tmp->next) index-=tmp->cnt;
+		} else {
+			index=Size-1-index;
+			for (tmp=rear; index>=tmp->cnt; tmp=tmp->pre) index-=tmp->cnt;
+			index=tmp->cnt-1-index;
+		}
+		off=index;
+		return tmp;
+	}
+
+	node *newNodeAfter(node *cur) {
+		node *tmp=new node(cur,cur==NULL?front:cur->next);
+		if (tmp->pre!=NULL) {
+			tmp->pre->next=tmp;
+		} else {
+			front=tmp;
+		}
+		if (tmp->next!=NULL) {
+			tmp->next->pre=tmp;
+		} else {
+			rear=tmp;
+		}
+		return tmp;
+	}
+
+	void unlink(node *cur) {
+		if (cur->pre!=NULL) {
+			cur->pre->next=cur->next;
+		} else {
+			front=cur->next;
+		}
+		if (cur->next!=NULL) {
+			cur->next->pre=cur->pre;
+		} else {
+			rear=cur->pre;
+		}
+		delete cur;
+	}
+
+	/**
+	 * Inserts e at offset off of cur, splitting cur first if it is full.
+	 */
+	void insertAt(node *cur, int off, const T &e) {
+		if (cur->cnt==B) {
+			node *tmp=newNodeAfter(cur);
+			int half=B/2;
+			for (int i=half; i<B; ++i) tmp->data[i-half]=cur->data[i];
+			tmp->cnt=B-half;
+			cur->cnt=half;
+			if (off>half) {
+				cur=tmp;
+				off-=half;
+			}
+		}
+		for (int i=cur->cnt; i>off; --i) cur->data[i]=cur->data[i-1];
+		cur->data[off]=e;
+		++cur->cnt;
+		++Size;
+	}
+
+	/**
+	 * Removes the element at offset off of cur and rebalances cur with its
+	 * successor. Stores in cur and off the position of the element that
+	 * followed the removed one (cur is NULL at the end of the list).
+	 */
+	void eraseAt(node *&cur, int &off) {
+		for (int i=off+1; i<cur->cnt; ++i) cur->data[i-1]=cur->data[i];
+		--cur->cnt;
+		--Size;
+		node *nxt=cur->next;
+		if (cur->cnt<B/4&&nxt!=NULL) {
+			if (cur->cnt+nxt->cnt<=B*3/4) {
+				for (int i=0; i<nxt->cnt; ++i) cur->data[cur->cnt+i]=nxt->data[i];
+				cur->cnt+=nxt->cnt;
+				unlink(nxt);
+			} else {
+				int k=(nxt->cnt-cur->cnt)/2;
+				for (int i=0; i<k; ++i) cur->data[cur->cnt+i]=nxt->data[i];
+				for (int i=k; i<nxt->cnt; ++i) nxt->data[i-k]=nxt->data[i];
+				cur->cnt+=k;
+				nxt->cnt-=k;
+			}
+		}
+		if (cur->cnt==0) {
+			node *tmp=cur->next;
+			unlink(cur);
+			cur=tmp;
+			off=0;
+		} else if (off>=cur->cnt) {
+			cur=cur->next;
+			off=0;
+		}
+	}
+
+	void copyFrom(const UnrolledLinkedList &c) {
+		front=rear=NULL;
+		for (node *cur=c.front; cur!=NULL; cur=cur->next) {
+			node *tmp=newNodeAfter(rear);
+			for (int i=0; i<cur->cnt; ++i) tmp->data[i]=cur->data[i];
+			tmp->cnt=cur->cnt;
+		}
+		Size=c.Size;
+	}
+
+public:
+    class Iterator
+    {
+		UnrolledLinkedList *a;
+		// position of the next element to return, and of the last one returned
+		node *pos, *last;
+		int off, lastOff;
+		bool started;
+
+		void normalize() {
+			if (!started) {
+				pos=a->front;
+				off=0;
+				started=true;
+			}
+		}
+
+    public:
+		Iterator(UnrolledLinkedList *x) {
+			a=x;
+			pos=last=NULL;
+			off=lastOff=0;
+			started=false;
+		}
+
+        /**
+         * Returns true if the iteration has more elements.
+         */
+        bool hasNext() {
+			normalize();
+			return pos!=NULL;
+		}
+
+        /**
+         * Returns the next element in the iteration.
+         * @throw ElementNotExist exception when hasNext() == false
+         */
+        const T &next() {
+			if (!hasNext()) throw ElementNotExist("\nElement Not Exist\n");
+			last=pos;
+			lastOff=off;
+			if (++off==pos->cnt) {
+				pos=pos->next;
+				off=0;
+			}
+			return last->data[lastOff];
+		}
+
+        /**
+         * Removes from the underlying collection the last element
+         * returned by the iterator
+         * The behavior of an iterator is unspecified if the underlying
+         * collection is modified while the iteration is in progress in
+         * any way other than by calling this method.
+         * @throw ElementNotExist
+         */
+        void remove() {
+			if (last==NULL) throw ElementNotExist("\nElement Not Exist\n");
+			a->eraseAt(last,lastOff);
+			pos=last;
+			off=lastOff;
+			last=NULL;
+		}
+    };
+
+    /**
+     * Constructs an empty list
+     */
+    UnrolledLinkedList() {
+		front=rear=NULL;
+		Size=0;
+	}
+
+    /**
+     * Copy constructor
+     */
+    UnrolledLinkedList(const UnrolledLinkedList &c) {
+		copyFrom(c);
+	}
+
+    /**
+     * Assignment operator
+     */
+    UnrolledLinkedList& operator=(const UnrolledLinkedList &c) {
+		if (this!=&c) {
+			clear();
+			copyFrom(c);
+		}
+		return *this;
+	}
+
+    /**
+     * Destructor
+     */
+    ~UnrolledLinkedList() {
+		clear();
+	}
+
+    /**
+     * Appends the specified element to the end of this list.
+     * Always returns true.
+     */
+    bool add(const T& e) {
+		addLast(e);
+		return true;
+	}
+
+    /**
+     * Inserts the specified element to the beginning of this list.
+     */
+    void addFirst(const T& elem) {
+		if (front==NULL) newNodeAfter(NULL);
+		insertAt(front,0,elem);
+	}
+
+    /**
+     * Insert the specified element to the end of this list.
+     * Equivalent to add.
+     */
+    void addLast(const T &elem) {
+		if (rear==NULL||rear->cnt==B) newNodeAfter(rear);
+		insertAt(rear,rear->cnt,elem);
+	}
+
+    /**
+     * Inserts the specified element to the specified position in this list.
+     * The range of index parameter is [0, size], where index=0 means inserting to the head,
+     * and index=size means appending to the end.
+     * @throw IndexOutOfBound
+     */
+    void add(int index, const T& element) {
+		if (index<0||index>Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		if (index==Size) {
+			addLast(element);
+			return;
+		}
+		int off;
+		node *tmp=locate(index,off);
+		insertAt(tmp,off,element);
+	}
+
+    /**
+     * Removes all of the elements from this list.
+     */
+    void clear() {
+		node *cur=front;
+		while (cur!=NULL) {
+			node *tmp=cur->next;
+			delete cur;
+			cur=tmp;
+		}
+		Size=0;
+		front=rear=NULL;
+	}
+
+    /**
+     * Returns true if this list contains the specified element.
+     */
+    bool contains(const T& e) const {
+		for (node *tmp=front; tmp!=NULL; tmp=tmp->next) {
+			for (int i=0; i<tmp->cnt; ++i) {
+				if (tmp->data[i]==e) return true;
+			}
+		}
+		return false;
+	}
+
+    /**
+     * Returns a const reference to the element at the specified position in this list.
+     * The index is zero-based, with range [0, size).
+     * @throw IndexOutOfBound
+     */
+    const T& get(int index) const {
+		if (index<0||index>=Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		int off;
+		node *tmp=locate(index,off);
+		return tmp->data[off];
+	}
+
+    /**
+     * Returns a const reference to the first element.
+     * @throw ElementNotExist
+     */
+    const T& getFirst() const {
+		if (front==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return front->data[0];
+	}
+
+    /**
+     * Returns a const reference to the last element.
+     * @throw ElementNotExist
+     */
+    const T& getLast() const {
+		if (rear==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		return rear->data[rear->cnt-1];
+	}
+
+    /**
+     * Returns true if this list contains no elements.
+     */
+    bool isEmpty() const {
+		return Size==0;
+	}
+
+    /**
+     * Removes the element at the specified position in this list.
+     * The index is zero-based, with range [0, size).
+     * @throw IndexOutOfBound
+     */
+    void removeIndex(int index) {
+		if (index<0||index>=Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		int off;
+		node *tmp=locate(index,off);
+		eraseAt(tmp,off);
+	}
+
+    /**
+     * Removes the first occurrence of the specified element from this list, if it is present.
+     * Returns true if it was present in the list, otherwise false.
+     */
+    bool remove(const T &e) {
+		for (node *tmp=front; tmp!=NULL; tmp=tmp->next) {
+			for (int i=0; i<tmp->cnt; ++i) {
+				if (tmp->data[i]==e) {
+					eraseAt(tmp,i);
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+    /**
+     * Removes the first element from this list.
+     * @throw ElementNotExist
+     */
+    void removeFirst() {
+		if (front==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		node *tmp=front;
+		int off=0;
+		eraseAt(tmp,off);
+	}
+
+    /**
+     * Removes the last element from this list.
+     * @throw ElementNotExist
+     */
+    void removeLast() {
+		if (rear==NULL) throw ElementNotExist("\nElement Not Exist\n");
+		--Size;
+		if (--rear->cnt==0) unlink(rear);
+	}
+
+    /**
+     * Replaces the element at the specified position in this list with the specified element.
+     * The index is zero-based, with range [0, size).
+     * @throw IndexOutOfBound
+     */
+    void set(int index, const T &element) {
+		if (index<0||index>=Size) throw IndexOutOfBound("\nIndex Out Of Bound\n");
+		int off;
+		node *tmp=locate(index,off);
+		tmp->data[off]=element;
+	}
+
+    /**
+     * Returns the number of elements in this list.
+     */
+    int size() const {
+		return Size;
+	}
+
+    /**
+     * Returns an iterator over the elements in this list.
+     */
+    Iterator iterator() {
+		return Iterator(this);
+	}
+};
+
+#endif
@@ -0,0 +1,44 @@
+// Steady push/pop churn on a PriorityQueue holding a fixed number of live
+// elements (arguments: number of push/pop pairs, default 10^9, and the live
+// count, default 1000). The peak resident set is printed every tenth of the
+// run; it must stay flat, since the heap only ever holds the live elements.
+// Build and run from the repo root (POSIX, for getrusage):
+//   g++ -std=c++98 -O2 -I. bench/PriorityQueueChurnBench.cpp -o pq_churn_bench && ./pq_churn_bench
+#include "PriorityQueue.h"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <sys/resource.h>
+
+static long maxRssKb() {
+	struct rusage u;
+	getrusage(RUSAGE_SELF, &u);
+	return u.ru_maxrss;
+}
+
+int main(int argc, char **argv) {
+	long long pairs=argc>1?std::atoll(argv[1]):1000000000LL;
+	int live=argc>2?std::atoi(argv[2]):1000;
+	PriorityQueue<long long> q;
+	unsigned state=12345;
+	long long now=0;
+	for (int i=0; i<live; ++i) {
+		state=state*1103515245u+12345u;
+		q.push(state%1000000);
+	}
+	long long step=pairs/10>0?pairs/10:1;
+	std::clock_t start=std::clock();
+	for (long long i=1; i<=pairs; ++i) {
+		// a timer queue: pop the earliest deadline, schedule a later one
+		now=q.front();
+		q.pop();
+		state=state*1103515245u+12345u;
+		q.push(now+state%1000000);
+		if (i%step==0) {
+			double s=(double)(std::clock()-start)/CLOCKS_PER_SEC;
+			std::printf("%12lld pairs  %6.1f s  %6.1f ns/pair  size %d  max rss %ld KB\n", i, s, s*1e9/i, q.size(), maxRssKb());
+			std::fflush(stdout);
+		}
+	}
+	return 0;
+}
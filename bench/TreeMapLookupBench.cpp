@@ -0,0 +1,59 @@
+// Lookup throughput of TreeMap: get() on present keys and containsKey() on
+// absent ones, over a map of N random keys (arguments: N, default 10^6, and
+// the number of lookup rounds, default 5). Build and run from the repo root:
+//   g++ -std=c++98 -O2 -I. bench/TreeMapLookupBench.cpp -o treemap_bench && ./treemap_bench
+// To compare against the recursive TreeMap that descended twice per get(),
+// put the old header first on the include path:
+//   mkdir -p /tmp/old && git show 4fe3351^:TreeMap.h > /tmp/old/TreeMap.h
+//   g++ -std=c++98 -O2 -I/tmp/old -I. bench/TreeMapLookupBench.cpp -o treemap_bench_old && ./treemap_bench_old
+// the old header used time() without including <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include "TreeMap.h"
+
+static unsigned state=12345;
+
+static int nextKey() {
+	state=state*1103515245u+12345u;
+	return (int)(state>>1);
+}
+
+static double msSince(std::clock_t start) {
+	return (std::clock()-start)*1000.0/CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv) {
+	int n=argc>1?std::atoi(argv[1]):1000000;
+	int rounds=argc>2?std::atoi(argv[2]):5;
+	// even keys go in, odd keys are the misses
+	int *keys=new int[n];
+	for (int i=0; i<n; ++i) keys[i]=nextKey()&~1;
+	TreeMap<int, int> m;
+	std::clock_t start=std::clock();
+	for (int i=0; i<n; ++i) m.put(keys[i], i);
+	std::printf("put      %8.1f ns/op\n", msSince(start)*1e6/n);
+
+	long long sum=0;
+	start=std::clock();
+	for (int r=0; r<rounds; ++r) {
+		for (int i=0; i<n; ++i) sum+=m.get(keys[(i*7919LL+r)%n]);
+	}
+	std::printf("get hit  %8.1f ns/op\n", msSince(start)*1e6/((double)n*rounds));
+
+	int found=0;
+	start=std::clock();
+	for (int r=0; r<rounds; ++r) {
+		for (int i=0; i<n; ++i) found+=m.containsKey(keys[(i*7919LL+r)%n]|1);
+	}
+	std::printf("miss     %8.1f ns/op\n", msSince(start)*1e6/((double)n*rounds));
+
+	start=std::clock();
+	for (int i=0; i<n; ++i) {
+		if (m.containsKey(keys[i])) m.remove(keys[i]);
+	}
+	std::printf("remove   %8.1f ns/op\n", msSince(start)*1e6/n);
+	std::printf("(checksum %lld %d %d)\n", sum, found, m.size());
+	delete[] keys;
+	return 0;
+}
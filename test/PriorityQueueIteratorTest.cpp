@@ -0,0 +1,78 @@
+// Regression test for PriorityQueue::Iterator::remove() with a comparator
+// that orders on part of the element only. Build and run from the repo root:
+//   g++ -std=c++98 -Wall -I. test/PriorityQueueIteratorTest.cpp -o pq_iter_test && ./pq_iter_test
+#include "PriorityQueue.h"
+#include <cstdio>
+
+struct Item {
+	int key, id;
+	Item() : key(0), id(0) {}
+	Item(int key, int id) : key(key), id(id) {}
+};
+
+// equal keys compare equal, whatever the ids
+struct KeyLess {
+	bool operator()(const Item &a, const Item &b) { return a.key<b.key; }
+};
+
+template <int D>
+static int run(int n, int keys) {
+	PriorityQueue<Item, KeyLess, D> q;
+	unsigned r=12345;
+	for (int i=0; i<n; ++i) {
+		r=r*1103515245u+12345u;
+		q.push(Item((r>>16)%keys, i));
+	}
+	// remove every element with an even id while iterating
+	int seen[4096]={0};
+	typename PriorityQueue<Item, KeyLess, D>::Iterator it=q.iterator();
+	while (it.hasNext()) {
+		const Item &x=it.next();
+		++seen[x.id];
+		if (x.id%2==0) it.remove();
+	}
+	int fails=0;
+	for (int i=0; i<n; ++i) {
+		if (seen[i]!=1) {
+			std::printf("D=%d n=%d: id %d returned %d times\n", D, n, i, seen[i]);
+			++fails;
+		}
+	}
+	int left[4096]={0}, count=0;
+	for (typename PriorityQueue<Item, KeyLess, D>::Iterator i=q.iterator(); i.hasNext(); ++count) ++left[i.next().id];
+	if (count!=n/2) {
+		std::printf("D=%d n=%d: %d elements left, expected %d\n", D, n, count, n/2);
+		++fails;
+	}
+	for (int i=0; i<n; ++i) {
+		if (left[i]!=i%2) {
+			std::printf("D=%d n=%d: id %d left %d times\n", D, n, i, left[i]);
+			++fails;
+		}
+	}
+	int prev=-1;
+	while (!q.empty()) {
+		if (q.front().key<prev) {
+			std::printf("D=%d n=%d: heap order broken\n", D, n);
+			++fails;
+			break;
+		}
+		prev=q.front().key;
+		q.pop();
+	}
+	return fails;
+}
+
+int main() {
+	int fails=0;
+	for (int n=1; n<=4096; n*=4) {
+		for (int keys=1; keys<=64; keys*=8) {
+			fails+=run<2>(n, keys);
+			fails+=run<3>(n, keys);
+			fails+=run<4>(n, keys);
+		}
+	}
+	if (fails) return 1;
+	std::printf("ok\n");
+	return 0;
+}